@@ -0,0 +1,119 @@
+// primecart_linux_cfs.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "primecart_cli.h"
+
+void cfs_on_dispatch(SchedSim* sim, int task, int first_run) {
+    if (first_run) {
+        LinuxProcess* p = &sim->procs[task];
+        printf("[Time %.3fms] %s started (Response Time: %.3fms)\n", 
+               sim_ms(sim->current_time), p->pid, sim_ms(p->response_time));
+    }
+}
+
+void cfs_on_preempt(SchedSim* sim, int task, int next, int reason) {
+    (void)next;
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s %s (vruntime %.3fms, %gms remaining)\n",
+           sim_ms(sim->current_time), p->pid,
+           reason == SCHED_PREEMPT_PRIORITY ? "preempted by wakeup" : "slice expired",
+           sim_ms(p->vruntime), sim_ms(p->remaining_time));
+}
+
+void cfs_on_complete(SchedSim* sim, int task) {
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s completed\n", sim_ms(sim->current_time), p->pid);
+    printf("      Turnaround: %.3fms, Waiting: %.3fms\n\n",
+           sim_ms(p->turnaround_time),
+           sim_ms(p->waiting_time));
+}
+
+void run_linux_cfs_analysis(const SimOptions* options, const Workload* workload) {
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX LPUS BACKEND CFS ANALYSIS\n");
+    printf("Ubuntu 22.04 LTS Server | Completely Fair Scheduler (Latency: %gms, Min Granularity: %gms)\n",
+           CFS_TARGET_LATENCY, CFS_MIN_GRANULARITY);
+    printf("Workload: %s (%zu processes)\n", workload->name, workload->count);
+    printf("================================================================================\n");
+    
+    SchedSim sim;
+    sim_init(&sim, &CFS_POLICY, workload);
+    sim_apply_options(&sim, options);
+    
+    if (options->quiet) {
+        sim_run(&sim, NULL);
+    } else {
+        // Print Process Table
+        sim_print_process_table(workload, "PROCESS TABLE (Sorted by Arrival Time):");
+        
+        printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
+        printf("================================================================================\n\n");
+        
+        // Main scheduling loop
+        SchedHooks hooks = { cfs_on_dispatch, cfs_on_preempt, cfs_on_complete };
+        sim_run(&sim, &hooks);
+        
+        // Print Gantt Chart
+        sim_print_gantt(&sim, "CFS SCHEDULING (Virtual Runtime Order)", 1);
+    }
+    
+    sim_print_system_metrics(&sim, " (CFS Scheduling)");
+    sim_print_class_metrics(&sim, " (POS vs LPUS under CFS)");
+    sim_print_tail_latency(&sim, " (POS vs LPUS under CFS)");
+    
+    if (!options->quiet) {
+        sim_print_process_metrics(&sim, " (CFS Execution)", NULL, sim.count);
+    }
+    
+    // PrimeCart Threshold Analysis
+    const char* const why[5] = {
+        "A waking POS task has the lowest vruntime but still waits on the interrupt",
+        "Fair slices already stretch with the runnable count; jitter adds to that",
+        "Wakeup preemption and 0.75ms minimum slices put switches on the hot path",
+        "Fair sharing slows every task once the CPU saturates, POS included",
+        "LPUS results reach POS terminals without spending the POS CPU share"
+    };
+    sim_print_threshold_analysis(&sim, " - CFS", why);
+    
+    // CFS Algorithm Analysis
+    printf("\n================================================================================\n");
+    printf("CFS ALGORITHM ANALYSIS\n");
+    printf("================================================================================\n");
+    
+    printf("\nCFS Selection Logic:\n");
+    printf("• Ready tasks kept in a red-black tree ordered by virtual runtime\n");
+    printf("• Leftmost task (least weighted CPU time) runs next\n");
+    printf("• Priority 1-5 maps to nice -10..+10 (POS weight %d vs LPUS %d)\n",
+           cfs_nice_to_weight[cfs_priority_to_nice(1) + 20], cfs_nice_to_weight[cfs_priority_to_nice(4) + 20]);
+    printf("• Slice = max(%gms, n x %gms) x weight / total weight\n", CFS_TARGET_LATENCY, CFS_MIN_GRANULARITY);
+    printf("• A waking task preempts once it trails by > %gms of virtual time\n", CFS_WAKEUP_GRANULARITY);
+    
+    printf("\nImpact on LPUS Backend Operations:\n");
+    printf("✓ Matches the Ubuntu 22.04 default scheduler\n");
+    printf("✓ POS tasks get a large weighted share and fast wakeups\n");
+    printf("✓ LPUS jobs still progress: no starvation\n");
+    printf("✗ No hard priority: LPUS load still delays POS under saturation\n");
+    printf("✗ Short slices under load raise context switch overhead\n");
+    
+    printf("\n================================================================================\n");
+    printf("ANALYSIS COMPLETE\n");
+    printf("================================================================================\n");
+    
+    sim_free(&sim);
+}
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    Workload workload;
+    if (sim_parse_options(&options, argc, argv) != 0) return 1;
+    if (sim_open_workload(&options, &workload) != 0) return 1;
+    
+    run_linux_cfs_analysis(&options, &workload);
+    
+    workload_free(&workload);
+    return 0;
+}
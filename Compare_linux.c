@@ -0,0 +1,153 @@
+// primecart_linux_compare.c
+// Runs every scheduling policy over the same workload at once and prints
+// one comparison table. The workload is loaded (or mapped) once and shared
+// read-only; each policy run gets its own simulation on a worker thread.
+//
+//   ./compare --workload blackfriday.bin --jobs 8
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "primecart_parallel.h"
+
+typedef struct {
+    const SimOptions* options;
+    const Workload* workload;      // shared, read-only
+    const SchedPolicy* policies[SIM_POLICY_COUNT];
+    SimSummary results[SIM_POLICY_COUNT];
+} CompareRun;
+
+// One policy over the shared workload (runs on a worker thread)
+void compare_job(void* ctx, int index) {
+    CompareRun* run = (CompareRun*)ctx;
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    SchedSim sim;
+    sim_init(&sim, run->policies[index], run->workload);
+    sim_apply_options(&sim, run->options);
+    sim_enable_streaming(&sim); // only the summary is needed
+    sim_run(&sim, NULL);
+    sim_summarize(&sim, &run->results[index]);
+    sim_free(&sim);
+
+    run->results[index].wall_seconds = parallel_elapsed(&started);
+}
+
+void print_comparison(const CompareRun* run, int count) {
+    printf("\n================================================================================\n");
+    printf("POLICY COMPARISON (times in ms)\n");
+    printf("================================================================================\n");
+    printf("\n+---------------------+------------+------------+------------+------------+------------+------------+--------+------------+------------+---------+\n");
+    printf("| Policy              | Avg Wait   | P99 Wait   | Avg Resp   | P99 Resp   | Avg Turn   | P99 Turn   | Util   | Tasks/s    | Switches   | Run (s) |\n");
+    printf("+---------------------+------------+------------+------------+------------+------------+------------+--------+------------+------------+---------+\n");
+    for (int i = 0; i < count; i++) {
+        const SimSummary* s = &run->results[i];
+        printf("| %-19s | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %5.1f%% | %-10.2f | %-10lld | %7.2f |\n",
+               run->policies[i]->name,
+               s->avg_wait, s->p99_wait,
+               s->avg_response, s->p99_response,
+               s->avg_turnaround, s->p99_turnaround,
+               s->utilization, s->throughput,
+               s->context_switches, s->wall_seconds);
+    }
+    printf("+---------------------+------------+------------+------------+------------+------------+------------+--------+------------+------------+---------+\n");
+
+    // Best policy per headline metric
+    int best_wait = 0;
+    int best_response = 0;
+    int best_turnaround = 0;
+    int fewest_switches = 0;
+    for (int i = 1; i < count; i++) {
+        if (run->results[i].p99_wait < run->results[best_wait].p99_wait) best_wait = i;
+        if (run->results[i].p99_response < run->results[best_response].p99_response) best_response = i;
+        if (run->results[i].avg_turnaround < run->results[best_turnaround].avg_turnaround) best_turnaround = i;
+        if (run->results[i].context_switches < run->results[fewest_switches].context_switches) fewest_switches = i;
+    }
+    printf("\nLowest P99 Wait:         %s\n", run->policies[best_wait]->name);
+    printf("Lowest P99 Response:     %s\n", run->policies[best_response]->name);
+    printf("Lowest Avg Turnaround:   %s\n", run->policies[best_turnaround]->name);
+    printf("Fewest Context Switches: %s\n", run->policies[fewest_switches]->name);
+}
+
+void print_compare_usage(void) {
+    fprintf(stderr, "Compare options:\n");
+    fprintf(stderr, "  --jobs N          worker threads (default: online CPUs)\n");
+    fprintf(stderr, "  --policies LIST   comma-separated subset of (default: all)\n");
+    fprintf(stderr, "                    %s\n", SIM_POLICY_NAMES);
+}
+
+// Consume the compare options and drop them from argv. Fills policies[]
+// and returns the remaining argc, -1 on a bad option.
+int parse_compare_options(int argc, char** argv, CompareRun* run, int* count, int* jobs) {
+    const char* list = NULL;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            *jobs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--policies") == 0 && i + 1 < argc) {
+            list = argv[++i];
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+
+    *count = sim_parse_policy_list(list, run->policies);
+    if (*count < 0) {
+        print_compare_usage();
+        return -1;
+    }
+    return kept;
+}
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    Workload workload;
+    CompareRun run;
+    int count;
+    int jobs = parallel_default_threads();
+    memset(&run, 0, sizeof(run));
+
+    argc = parse_compare_options(argc, argv, &run, &count, &jobs);
+    if (argc < 0) return 1;
+    if (sim_parse_options(&options, argc, argv) != 0) {
+        print_compare_usage();
+        return 1;
+    }
+    if (options.trace_path != NULL || options.realtime) {
+        fprintf(stderr, "compare: --trace and --realtime apply to single-policy programs\n");
+        return 1;
+    }
+    if (sim_open_workload(&options, &workload) != 0) return 1;
+    workload_prepare_shared(&workload);
+
+    run.options = &options;
+    run.workload = &workload;
+
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX LPUS BACKEND SCHEDULING POLICY COMPARISON\n");
+    printf("Ubuntu 22.04 LTS Server | %d Policies on %d Worker Thread%s\n",
+           count, jobs < count ? jobs : count, (jobs < count ? jobs : count) == 1 ? "" : "s");
+    printf("Workload: %s (%zu processes, %d CPU%s)\n",
+           workload.name, workload.count, options.cpus, options.cpus == 1 ? "" : "s");
+    printf("================================================================================\n");
+
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    parallel_run(compare_job, &run, count, jobs);
+    double wall = parallel_elapsed(&started);
+
+    print_comparison(&run, count);
+
+    double serial = 0;
+    for (int i = 0; i < count; i++) {
+        serial += run.results[i].wall_seconds;
+    }
+    printf("\nWall Time:               %.2f s (%.2f s of simulation, %.2fx parallel speedup)\n",
+           wall, serial, wall > 0 ? serial / wall : 0.0);
+
+    workload_free(&workload);
+    return 0;
+}
@@ -4,291 +4,110 @@
 #include <unistd.h>
 #include <time.h>
 
-// Linux performance characteristics
-#define CONTEXT_SWITCH_LINUX 0.004    // 4 μs in ms (more efficient than typical systems)
-#define INTERRUPT_LATENCY_LINUX 0.080 // 80 μs in ms
-#define SCHEDULING_JITTER_LINUX 0.0015 // 1.5 ms
-#define IPC_THROUGHPUT_LINUX 950.0    // MB/s (Linux IPC outperforms typical systems)
+#include "primecart_cli.h"
 
-typedef struct {
-    char pid[4];
-    char description[50];
-    char process_type[12];
-    int arrival_time;    // ms
-    int burst_time;      // ms
-    int priority;        // 1=highest, 5=lowest
-    int start_time;      // ms
-    int exit_time;       // ms
-    int waiting_time;    // ms
-    int turnaround_time; // ms
-    int response_time;   // ms
-} LinuxProcess;
-
-LinuxProcess processes[] = {
-    {"P1", "LPUS Batch Update: SQL DB Write", "Background", 0, 20, 4, 0, 0, 0, 0, 0},
-    {"P2", "POS Scan Validation: Barcode Check", "Foreground", 1, 6, 1, 0, 0, 0, 0, 0},
-    {"P3", "POS Price Lookup: GUI Display", "Foreground", 2, 4, 1, 0, 0, 0, 0, 0},
-    {"P4", "LPUS Inventory Sync: Stock Upload", "Background", 4, 12, 4, 0, 0, 0, 0, 0},
-    {"P5", "POS Payment Auth: Data Encryption", "Foreground", 5, 8, 2, 0, 0, 0, 0, 0},
-    {"P6", "LPUS Metadata Refresh: Cache Update", "Background", 7, 10, 5, 0, 0, 0, 0, 0},
-    {"P7", "POS Receipt Gen: Log Transaction", "Foreground", 9, 4, 1, 0, 0, 0, 0, 0}                                                                                                                                                       
-};                                                                                                                                                                                                                                         
-                                                                                                                                                                                                                                           
-#define NUM_PROCESSES (sizeof(processes)/sizeof(processes[0]))                                                                                                                                                                             
-                                                                                                                                                                                                                                           
-void sort_by_arrival_time() {                                                                                                                                                                                                              
-    for (int i = 0; i < NUM_PROCESSES - 1; i++) {                                                                                                                                                                                          
-        for (int j = 0; j < NUM_PROCESSES - i - 1; j++) {                                                                                                                                                                                  
-            if (processes[j].arrival_time > processes[j + 1].arrival_time) {                                                                                                                                                               
-                LinuxProcess temp = processes[j];                                                                                                                                                                                          
-                processes[j] = processes[j + 1];                                                                                                                                                                                           
-                processes[j + 1] = temp;                                                                                                                                                                                                   
-            }
+void fcfs_on_dispatch(SchedSim* sim, int task, int first_run) {
+    (void)first_run;
+    LinuxProcess* p = &sim->procs[task];
+    
+    // Show convoy effect for POS tasks
+    if (sim->gantt.count > 0) {
+        const LinuxProcess* prev = &sim->procs[gantt_get(&sim->gantt, sim->gantt.count - 1).process_index];
+        if (p->arrival_time < prev->exit_time) {
+            printf("[Time %.3fms] %s ARRIVED but WAITING for %s to complete (Convoy Effect)\n", 
+                   sim_ms(p->arrival_time), p->pid, prev->pid);
         }
     }
+    
+    printf("[Time %.3fms] Starting %s\n", sim_ms(sim->current_time), p->pid);
+    printf("[Linux] Executing %s - %s\n", p->pid, p->description);
 }
 
-void print_gantt_chart() {
-    printf("\n================================================================================\n");
-    printf("GANTT CHART - FCFS SCHEDULING SEQUENCE\n");
-    printf("================================================================================\n\n");
-    
-    // Print timeline header
-    printf("Time(ms) ");
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("|");
-        // Scale: each character = 2ms
-        int scaled_length = processes[i].burst_time / 2;
-        for (int j = 0; j < scaled_length; j++) {
-            printf("-");
-        }
-    }
-    printf("|\n");
-    
-    // Print process labels
-    printf("         ");
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("|");
-        int scaled_length = processes[i].burst_time / 2;
-        printf("%-*s", scaled_length, processes[i].pid);
-    }
-    printf("|\n");
-    
-    // Print time markers
-    printf("        0");
-    int cumulative = 0;
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        cumulative += processes[i].burst_time;
-        int spacing = (processes[i].burst_time / 2) + 1;
-        printf("%*d", spacing, cumulative);
-    }
-    printf("\n");
-    
-    printf("\nExecution Sequence: ");
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("%s", processes[i].pid);
-        if (i < NUM_PROCESSES - 1) {
-            printf(" -> ");
-        }
-    }
-    printf("\n");
-    
-    printf("Note: Each '-' character represents 2ms of execution time\n");
-    printf("      Context switches (0.1ms) shown as gaps between processes\n");
+void fcfs_on_complete(SchedSim* sim, int task) {
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] Completed %s\n", sim_ms(p->exit_time), p->pid);
+    printf("         Waiting Time: %.3fms | Response Time: %.3fms | Turnaround Time: %.3fms\n\n",
+           sim_ms(p->waiting_time),
+           sim_ms(p->response_time),
+           sim_ms(p->turnaround_time));
 }
 
-void run_linux_fcfs_analysis() {
+void run_linux_fcfs_analysis(const SimOptions* options, const Workload* workload) {
     printf("================================================================================\n");
     printf("PRIMECART RETAIL - LINUX LPUS BACKEND FCFS ANALYSIS\n");
     printf("Ubuntu 22.04 LTS Server | Non-Preemptive FCFS Scheduling\n");
+    printf("Workload: %s (%zu processes)\n", workload->name, workload->count);
     printf("================================================================================\n");
     
-    sort_by_arrival_time();
+    SchedSim sim;
+    sim_init(&sim, &FCFS_POLICY, workload);
+    sim_apply_options(&sim, options);
     
-    // Print Process Execution Order Table
-    printf("\nPROCESS EXECUTION ORDER (Sorted by Arrival Time - FCFS):\n");
-    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
-    printf("| PID | Task Description                 | Type         | Arrival  | Burst    | Priority |\n");
-    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
-    
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("| %-3s | %-32s | %-12s | %-8d | %-8d | %-8d |\n",
-               processes[i].pid,
-               processes[i].description,
-               processes[i].process_type,
-               processes[i].arrival_time,
-               processes[i].burst_time,
-               processes[i].priority);
-    }
-    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
-    
-    // Execute FCFS Simulation
-    int current_time = 0;
-    int total_waiting_time = 0;
-    int total_turnaround_time = 0;
-    int total_response_time = 0;
-    int total_burst_time = 0;
-    int total_idle_time = 0;
-    
-    printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
-    printf("================================================================================\n\n");
-    
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        // Handle idle time - process waits until arrival
-        if (current_time < processes[i].arrival_time) {
-            total_idle_time += (processes[i].arrival_time - current_time);
-            current_time = processes[i].arrival_time;
-        }
-        
-        // Record start time
-        processes[i].start_time = current_time;
-        
-        // Calculate response time (time from arrival to first execution)
-        processes[i].response_time = processes[i].start_time - processes[i].arrival_time;
-        
-        // Show convoy effect for POS tasks
-        if (i > 0 && processes[i].arrival_time < processes[i-1].exit_time) {
-            printf("[Time %dms] %s ARRIVED but WAITING for %s to complete (Convoy Effect)\n", 
-                   processes[i].arrival_time, processes[i].pid, processes[i-1].pid);
-        }
+    if (options->quiet) {
+        sim_run(&sim, NULL);
+    } else {
+        // Print Process Execution Order Table
+        sim_print_process_table(workload, "PROCESS EXECUTION ORDER (Sorted by Arrival Time - FCFS):");
         
-        printf("[Time %dms] Starting %s\n", current_time, processes[i].pid);
-        printf("[Linux] Executing %s - %s\n", processes[i].pid, processes[i].description);
+        // Execute FCFS Simulation
+        printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
+        printf("================================================================================\n\n");
         
-        // Simulate execution (non-preemptive)
-        usleep(processes[i].burst_time * 1000);
+        SchedHooks hooks = { fcfs_on_dispatch, NULL, fcfs_on_complete };
+        sim_run(&sim, &hooks);
         
-        // Record completion time
-        processes[i].exit_time = current_time + processes[i].burst_time;
-        
-        // Calculate turnaround time (time from arrival to completion)
-        processes[i].turnaround_time = processes[i].exit_time - processes[i].arrival_time;
-        
-        // Calculate waiting time (time spent waiting in ready queue)
-        processes[i].waiting_time = processes[i].start_time - processes[i].arrival_time;
-        
-        printf("[Time %dms] Completed %s\n", processes[i].exit_time, processes[i].pid);
-        printf("         Waiting Time: %dms | Response Time: %dms | Turnaround Time: %dms\n\n",
-               processes[i].waiting_time,
-               processes[i].response_time,
-               processes[i].turnaround_time);
-        
-        // Accumulate totals
-        total_waiting_time += processes[i].waiting_time;
-        total_turnaround_time += processes[i].turnaround_time;
-        total_response_time += processes[i].response_time;
-        total_burst_time += processes[i].burst_time;
-        
-        current_time = processes[i].exit_time;
-        
-        // Add context switch overhead (Linux is more efficient)
-        if (i < NUM_PROCESSES - 1) {
-            current_time += 1; // 0.1ms context switch
-        }
+        // Print Gantt Chart
+        sim_print_gantt(&sim, "FCFS SCHEDULING SEQUENCE", 2);
     }
     
-    // Print Gantt Chart
-    print_gantt_chart();
-    
-    // Calculate averages (similar to other systems due to identical FCFS logic)
-    float avg_waiting_time = total_waiting_time / (float)NUM_PROCESSES;
-    float avg_turnaround_time = total_turnaround_time / (float)NUM_PROCESSES;
-    float avg_response_time = total_response_time / (float)NUM_PROCESSES;
-    
-    // Calculate CPU utilization
-    int total_execution_time = current_time;
-    float cpu_utilization = (total_burst_time * 100.0) / total_execution_time;
-    
-    // Print System-Wide Performance Metrics
-    printf("\n================================================================================\n");
-    printf("SYSTEM-WIDE PERFORMANCE METRICS\n");
-    printf("================================================================================\n");
-    
-    printf("\nAverage Waiting Time: %.1f ms\n", avg_waiting_time);
-    printf("Average Response Time: %.1f ms\n", avg_response_time);
-    printf("Average Turnaround Time: %.1f ms\n", avg_turnaround_time);
-    printf("CPU Utilization: %.1f%%\n", cpu_utilization);
-    printf("Throughput: %.2f processes/second\n", NUM_PROCESSES / (total_execution_time / 1000.0));
-    printf("Total Execution Time: %d ms\n", total_execution_time);
-    printf("Total CPU Busy Time: %d ms\n", total_burst_time);
-    printf("Total Idle Time: %d ms\n", total_idle_time);
-    
-    // Performance Analysis Table
-    printf("\n================================================================================\n");
-    printf("PROCESS PERFORMANCE METRICS\n");
-    printf("================================================================================\n");
-    
-    printf("\n+-----+----------+----------+----------+----------+----------+------------+\n");
-    printf("| PID | Arrival  | Burst    | Start    | Exit     | Wait     | Turnaround |\n");
-    printf("+-----+----------+----------+----------+----------+----------+------------+\n");
-    
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("| %-3s | %-8d | %-8d | %-8d | %-8d | %-8d | %-10d |\n",
-               processes[i].pid,
-               processes[i].arrival_time,
-               processes[i].burst_time,
-               processes[i].start_time,
-               processes[i].exit_time,
-               processes[i].waiting_time,
-               processes[i].turnaround_time);
+    sim_print_system_metrics(&sim, "");
+    sim_print_tail_latency(&sim, " (POS vs LPUS under FCFS)");
+    if (!options->quiet) {
+        sim_print_process_metrics(&sim, "", NULL, sim.count);
     }
-    printf("+-----+----------+----------+----------+----------+----------+------------+\n");
-    // PrimeCart Threshold Analysis (Non-table format)
-    printf("\n================================================================================\n");
-    printf("PRIMECART THRESHOLD ANALYSIS (Ubuntu 22.04 LTS Server)\n");
-    printf("================================================================================\n");
-    printf("Metric                 Target Threshold    Linux Value     Status   Why It Matters for PrimeCart\n");
-    printf("--------------------------------------------------------------------------------\n");
-    
-    // Interrupt Latency
-    const char* int_status = INTERRUPT_LATENCY_LINUX < 0.100 ? "PASS" : "FAIL";
-    printf("Interrupt Latency      < 0.100 ms          %-12s %-6s   Ensures POS scanner requests are processed immediately\n", 
-           "0.080 ms", int_status);
-    
-    // Scheduling Jitter
-    const char* jitter_status = SCHEDULING_JITTER_LINUX < 2.000 ? "PASS" : "FAIL";
-    printf("Scheduling Jitter      < 2.000 ms          %-12s %-6s   Prevents inconsistent LPUS response times to POS terminals\n", 
-           "0.001 ms", jitter_status);
     
-    // Context Switch Time
-    const char* cs_status = CONTEXT_SWITCH_LINUX <= 0.010 ? "PASS" : "FAIL";
-    printf("Context Switch Time    < 0.010 ms          %-12s %-6s   Linux's task_struct optimization enables highly efficient context switching\n", 
-           "0.004 ms", cs_status);
-
-    // CPU Utilization
-    const char* cpu_status = cpu_utilization < 75.0 ? "PASS" : "FAIL";
-    char cpu_value[20];
-    sprintf(cpu_value, "%.1f%%", cpu_utilization);
-    printf("CPU Utilization        < 75.0%%             %-12s %-6s   Fails to maintain headroom for traffic spikes, risking checkout delays\n", 
-           cpu_value, cpu_status);
-    
-    // IPC Throughput
-    const char* ipc_status = IPC_THROUGHPUT_LINUX > 500.0 ? "PASS" : "FAIL";
-    char ipc_value[20];
-    sprintf(ipc_value, "%.0f MB/s", IPC_THROUGHPUT_LINUX);
-    printf("IPC Throughput         > 500 MB/s          %-12s %-6s   Linux's efficient IPC mechanisms ensure fast POS-to-LPUS communication\n", 
-           ipc_value, ipc_status);
-    
-    printf("--------------------------------------------------------------------------------\n");    
-    // Convoy Effect Analysis
-    printf("\n================================================================================\n");
-    printf("CONVOY EFFECT ANALYSIS\n");
-    printf("================================================================================\n");
-    
-    printf("\nCritical Issue Detected: P1 (LPUS Batch Update) blocks all POS requests:\n\n");
-    printf("• P2 (POS Scan) arrived at 1ms but waited %dms for P1 to complete\n", processes[1].waiting_time);
-    printf("• P3 (POS Lookup) arrived at 2ms but waited %dms for P1 to complete\n", processes[2].waiting_time);
-    printf("• P5 (POS Payment) arrived at 5ms but waited %dms\n", processes[4].waiting_time);
-    printf("• P7 (POS Receipt) arrived at 9ms but waited %dms\n\n", processes[6].waiting_time);
-    
-    printf("Note: Linux handles context switches more efficiently (0.004ms) than many systems,\n");
-    printf("but the convoy effect from FCFS scheduling dominates performance degradation.\n");
+    // PrimeCart Threshold Analysis (Non-table format)
+    const char* const why[5] = {
+        "Ensures POS scanner requests are processed immediately",
+        "Prevents inconsistent LPUS response times to POS terminals",
+        "Linux's task_struct optimization enables highly efficient context switching",
+        "Fails to maintain headroom for traffic spikes, risking checkout delays",
+        "Linux's efficient IPC mechanisms ensure fast POS-to-LPUS communication"
+    };
+    sim_print_threshold_analysis(&sim, "", why);
+    
+    // Convoy Effect Analysis (written for the P1-P7 reference workload;
+    // reads per-task results, which a streaming run does not keep)
+    if (options->workload_path == NULL && !options->stream) {
+        printf("\n================================================================================\n");
+        printf("CONVOY EFFECT ANALYSIS\n");
+        printf("================================================================================\n");
+        
+        printf("\nCritical Issue Detected: P1 (LPUS Batch Update) blocks all POS requests:\n\n");
+        printf("• P2 (POS Scan) arrived at 1ms but waited %.3fms for P1 to complete\n", sim_ms(sim.procs[1].waiting_time));
+        printf("• P3 (POS Lookup) arrived at 2ms but waited %.3fms for P1 to complete\n", sim_ms(sim.procs[2].waiting_time));
+        printf("• P5 (POS Payment) arrived at 5ms but waited %.3fms\n", sim_ms(sim.procs[4].waiting_time));
+        printf("• P7 (POS Receipt) arrived at 9ms but waited %.3fms\n\n", sim_ms(sim.procs[6].waiting_time));
+        
+        printf("Note: Linux handles context switches more efficiently (%.3fms) than many systems,\n", sim_host.context_switch_ms);
+        printf("but the convoy effect from FCFS scheduling dominates performance degradation.\n");
+    }
     
     printf("\n================================================================================\n");
     printf("ANALYSIS COMPLETE\n");
     printf("================================================================================\n");
+    
+    sim_free(&sim);
 }
 
-int main() {
-    run_linux_fcfs_analysis();
+int main(int argc, char** argv) {
+    SimOptions options;
+    Workload workload;
+    if (sim_parse_options(&options, argc, argv) != 0) return 1;
+    if (sim_open_workload(&options, &workload) != 0) return 1;
+    
+    run_linux_fcfs_analysis(&options, &workload);
+    
+    workload_free(&workload);
     return 0;
+}
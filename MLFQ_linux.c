@@ -0,0 +1,201 @@
+// primecart_linux_mlfq.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "primecart_cli.h"
+
+void mlfq_on_dispatch(SchedSim* sim, int task, int first_run) {
+    if (first_run) {
+        LinuxProcess* p = &sim->procs[task];
+        printf("[Time %.3fms] %s started (Response Time: %.3fms)\n", 
+               sim_ms(sim->current_time), p->pid, sim_ms(p->response_time));
+    }
+}
+
+void mlfq_on_preempt(SchedSim* sim, int task, int next, int reason) {
+    (void)next;
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s %s (now level %d, %gms remaining)\n",
+           sim_ms(sim->current_time), p->pid,
+           reason == SCHED_PREEMPT_PRIORITY ? "preempted by higher level" : "allotment used",
+           p->level, sim_ms(p->remaining_time));
+}
+
+void mlfq_on_complete(SchedSim* sim, int task) {
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s completed\n", sim_ms(sim->current_time), p->pid);
+    printf("      Turnaround: %.3fms, Waiting: %.3fms\n\n",
+           sim_ms(p->turnaround_time),
+           sim_ms(p->waiting_time));
+}
+
+// Which level each task finished at, by class, over every CPU's queue
+void print_level_summary(const SchedSim* sim) {
+    printf("\n================================================================================\n");
+    printf("MLFQ LEVEL SUMMARY (Level at Completion)\n");
+    printf("================================================================================\n");
+    printf("\n+-------+------------+--------------+--------------+\n");
+    printf("| Level | Allotment  | Foreground   | Background   |\n");
+    printf("+-------+------------+--------------+--------------+\n");
+    for (int l = 0; l < mlfq_config.levels; l++) {
+        long long done[TASK_CLASS_COUNT] = {0};
+        for (int c = 0; c < sim->ncpus; c++) {
+            const MlfqRunqueue* rq = (const MlfqRunqueue*)sim->cpus[c].rq;
+            for (int k = 0; k < TASK_CLASS_COUNT; k++) {
+                done[k] += rq->done[l][k];
+            }
+        }
+        char allotment[16];
+        if (mlfq_config.quantum[l] > 0) {
+            snprintf(allotment, sizeof(allotment), "%g ms", sim_ms(mlfq_config.quantum[l]));
+        } else {
+            snprintf(allotment, sizeof(allotment), "unlimited");
+        }
+        printf("| %-5d | %-10s | %-12lld | %-12lld |\n",
+               l, allotment, done[TASK_CLASS_FOREGROUND], done[TASK_CLASS_BACKGROUND]);
+    }
+    printf("+-------+------------+--------------+--------------+\n");
+}
+
+void run_linux_mlfq_analysis(const SimOptions* options, const Workload* workload) {
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX LPUS BACKEND MLFQ ANALYSIS\n");
+    printf("Ubuntu 22.04 LTS Server | Multi-Level Feedback Queue (%d Levels, Boost: %gms)\n",
+           mlfq_config.levels, sim_ms(mlfq_config.boost_period));
+    printf("Workload: %s (%zu processes)\n", workload->name, workload->count);
+    printf("================================================================================\n");
+    
+    SchedSim sim;
+    sim_init(&sim, &MLFQ_POLICY, workload);
+    sim_apply_options(&sim, options);
+    
+    if (options->quiet) {
+        sim_run(&sim, NULL);
+    } else {
+        // Print Process Table
+        sim_print_process_table(workload, "PROCESS TABLE (Sorted by Arrival Time):");
+        
+        printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
+        printf("================================================================================\n\n");
+        
+        // Main scheduling loop
+        SchedHooks hooks = { mlfq_on_dispatch, mlfq_on_preempt, mlfq_on_complete };
+        sim_run(&sim, &hooks);
+        
+        // Print Gantt Chart
+        sim_print_gantt(&sim, "MLFQ SCHEDULING (Feedback Queue Order)", 1);
+    }
+    
+    sim_print_system_metrics(&sim, " (MLFQ Scheduling)");
+    sim_print_class_metrics(&sim, " (POS vs LPUS under MLFQ)");
+    sim_print_tail_latency(&sim, " (POS vs LPUS under MLFQ)");
+    print_level_summary(&sim);
+    
+    if (!options->quiet) {
+        sim_print_process_metrics(&sim, " (MLFQ Execution)", NULL, sim.count);
+    }
+    
+    // PrimeCart Threshold Analysis
+    const char* const why[5] = {
+        "New POS arrivals enter the top queue and must start without delay",
+        "Late wake-ups can push interactive tasks past their allotment and demote them",
+        "Top-level allotments last a few ms, so POS tasks are switched often",
+        "Without idle time only the periodic boost keeps LPUS jobs moving",
+        "POS tasks blocked on LPUS replies keep their top-queue level"
+    };
+    sim_print_threshold_analysis(&sim, " - MLFQ", why);
+    
+    // MLFQ Algorithm Analysis
+    printf("\n================================================================================\n");
+    printf("MLFQ ALGORITHM ANALYSIS\n");
+    printf("================================================================================\n");
+    
+    printf("\nMLFQ Selection Logic:\n");
+    printf("• Every task enters the top level; the highest non-empty level runs first\n");
+    printf("• Using up a level's allotment demotes the task one level\n");
+    printf("• A task arriving at a higher level preempts a lower-level one\n");
+    printf("• Every %gms all tasks are boosted back to the top level\n", sim_ms(mlfq_config.boost_period));
+    printf("• Non-empty levels tracked in a bitmap: O(1) selection\n");
+    
+    printf("\nImpact on LPUS Backend Operations:\n");
+    printf("✓ Short POS bursts finish at the top level without knowing burst lengths\n");
+    printf("✓ 20ms batch jobs sink to lower levels and stop delaying checkouts\n");
+    printf("✓ Periodic boost prevents LPUS starvation\n");
+    printf("✗ Long POS tasks (payments) can be demoted like batch jobs\n");
+    printf("✗ Allotments and boost period need tuning per store load\n");
+    
+    printf("\n================================================================================\n");
+    printf("ANALYSIS COMPLETE\n");
+    printf("================================================================================\n");
+    
+    sim_free(&sim);
+}
+
+void print_mlfq_usage(void) {
+    fprintf(stderr, "MLFQ options:\n");
+    fprintf(stderr, "  --levels N       queue levels, 1-%d (default 3)\n", MLFQ_MAX_LEVELS);
+    fprintf(stderr, "  --quanta LIST    comma-separated allotments in ms, top level first; the\n");
+    fprintf(stderr, "                   last one repeats doubled, 0 = unlimited (default 8,16,32)\n");
+    fprintf(stderr, "  --boost MS       priority boost period, 0 = never (default 200)\n");
+}
+
+// Consume the MLFQ options into mlfq_config and drop them from argv.
+// Returns the remaining argc, -1 on a bad option.
+int parse_mlfq_options(int argc, char** argv) {
+    const char* quanta = NULL;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+            mlfq_config.levels = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quanta") == 0 && i + 1 < argc) {
+            quanta = argv[++i];
+        } else if (strcmp(argv[i], "--boost") == 0 && i + 1 < argc) {
+            mlfq_config.boost_period = MS_TO_NS(atof(argv[++i]));
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    if (mlfq_config.levels < 1 || mlfq_config.levels > MLFQ_MAX_LEVELS || mlfq_config.boost_period < 0) {
+        print_mlfq_usage();
+        return -1;
+    }
+
+    int given = 3; // defaults
+    if (quanta != NULL) {
+        given = 0;
+        for (const char* q = quanta; *q && given < MLFQ_MAX_LEVELS; ) {
+            char* end;
+            double ms = strtod(q, &end);
+            if (end == q || ms < 0) {
+                print_mlfq_usage();
+                return -1;
+            }
+            mlfq_config.quantum[given++] = MS_TO_NS(ms);
+            q = *end == ',' ? end + 1 : end;
+        }
+    }
+    for (int l = given; l < mlfq_config.levels; l++) {
+        mlfq_config.quantum[l] = l > 0 ? mlfq_config.quantum[l - 1] * 2 : 0;
+    }
+    return kept;
+}
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    Workload workload;
+    argc = parse_mlfq_options(argc, argv);
+    if (argc < 0) return 1;
+    if (sim_parse_options(&options, argc, argv) != 0) {
+        print_mlfq_usage();
+        return 1;
+    }
+    if (sim_open_workload(&options, &workload) != 0) return 1;
+    
+    run_linux_mlfq_analysis(&options, &workload);
+    
+    workload_free(&workload);
+    return 0;
+}
@@ -0,0 +1,429 @@
+// Probe_linux.c
+// Measures this host and saves the figures as a host profile: context-switch
+// latency (--switch), cyclictest-style wake-up latency and jitter (--jitter)
+// and IPC throughput and latency (--ipc); without a mode flag all of them
+// run. The simulators charge the measured switch cost and grade the
+// threshold rows against the measured figures when run with
+// --host-profile FILE.
+//
+//   ./probe --jitter --load 2 --duration 30 --output primecart_host.profile
+//   ./probe --ipc --sizes 64,4096,65536 --batches 1,32 --csv ipc.csv
+//   ./fcfs --host-profile primecart_host.profile
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "primecart_probe.h"
+#include "primecart_ipcbench.h"
+#include "primecart_host.h"
+
+#define PROBE_COUNT 4
+#define IPC_MAX_SWEEP 16        // message sizes, and batch sizes, per run
+
+typedef struct {
+    size_t sizes[IPC_MAX_SWEEP];
+    int nsizes;
+    int batches[IPC_MAX_SWEEP];
+    int nbatches;
+    long long megabytes;        // per throughput point
+    long long max_messages;     // per throughput point
+    int latency_rounds;
+    const char* csv_path;       // full sweep as CSV, NULL = none
+} IpcSweep;
+
+void print_probe_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--switch] [--jitter] [--ipc] [options]\n", program);
+    fprintf(stderr, "  --switch         context-switch latency (thread and process ping-pong)\n");
+    fprintf(stderr, "  --jitter         wake-up latency of periodic timers on every CPU\n");
+    fprintf(stderr, "  --ipc            FIFO, Unix socket and shared-memory transfer benchmark\n");
+    fprintf(stderr, "  --iterations N   --switch: timed round trips per probe (default 20000)\n");
+    fprintf(stderr, "  --interval US    --jitter: timer period (default 1000)\n");
+    fprintf(stderr, "  --duration S     --jitter: measuring time (default 5)\n");
+    fprintf(stderr, "  --load N         --jitter: LPUS-style batch threads per CPU (default 0)\n");
+    fprintf(stderr, "  --timer nanosleep|timerfd  --jitter: wake-up source (default nanosleep)\n");
+    fprintf(stderr, "  --fifo PRIO      --jitter: run the timer threads SCHED_FIFO (needs privileges)\n");
+    fprintf(stderr, "  --sizes LIST     --ipc: message sizes in bytes (default 64,512,4096,65536)\n");
+    fprintf(stderr, "  --batches LIST   --ipc: messages per send (default 1,16)\n");
+    fprintf(stderr, "  --megabytes MB   --ipc: data per throughput point (default 64)\n");
+    fprintf(stderr, "  --csv FILE       --ipc: also write the full sweep as CSV\n");
+    fprintf(stderr, "  --output FILE    host profile to update (default primecart_host.profile)\n");
+    fprintf(stderr, "  --no-save        only print the measurements\n");
+}
+
+double probe_us(uint64_t ns) {
+    return ns / 1000.0;
+}
+
+void print_switch_report(const SwitchProbe probes[PROBE_COUNT]) {
+    printf("\n================================================================================\n");
+    printf("CONTEXT SWITCH LATENCY (one-way handoff, us)\n");
+    printf("================================================================================\n");
+    printf("\n+------------------+----------+----------+----------+----------+----------+----------+----------+\n");
+    printf("| Probe            | CPU      | Mean     | P50      | P99      | P99.9    | Max      | Samples  |\n");
+    printf("+------------------+----------+----------+----------+----------+----------+----------+----------+\n");
+    for (int i = 0; i < PROBE_COUNT; i++) {
+        const SwitchProbe* p = &probes[i];
+        char cpu[24];
+        if (p->pin_cpu >= 0) {
+            snprintf(cpu, sizeof(cpu), "pinned %d", p->pin_cpu);
+        } else {
+            snprintf(cpu, sizeof(cpu), "any");
+        }
+        if (!p->ok) {
+            printf("| %-16s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s |\n",
+                   p->name, cpu, "failed", "-", "-", "-", "-", "-");
+            continue;
+        }
+        printf("| %-16s | %-8s | %-8.3f | %-8.3f | %-8.3f | %-8.3f | %-8.3f | %-8llu |\n",
+               p->name, cpu,
+               hist_mean(&p->handoff) / 1000.0,
+               probe_us(hist_percentile(&p->handoff, 50.0)),
+               probe_us(hist_percentile(&p->handoff, 99.0)),
+               probe_us(hist_percentile(&p->handoff, 99.9)),
+               probe_us(p->handoff.max),
+               (unsigned long long)p->handoff.count);
+    }
+    printf("+------------------+----------+----------+----------+----------+----------+----------+----------+\n");
+
+    for (int i = 0; i < PROBE_COUNT; i++) {
+        if (!probes[i].ok) continue;
+        printf("\n%s, %s:\n", probes[i].name, probes[i].pin_cpu >= 0 ? "pinned" : "unpinned");
+        hist_print_distribution(&probes[i].handoff, "  ");
+    }
+}
+
+// Returns 0 and updates profile, -1 if nothing could be measured
+int run_switch_probe(int iterations, HostProfile* profile) {
+    int cpu = probe_first_cpu();
+
+    // Thread (futex) and process (pipe) pairs, each pinned to one CPU and free
+    SwitchProbe probes[PROBE_COUNT] = {
+        {.name = "Thread (futex)", .pin_cpu = cpu},
+        {.name = "Thread (futex)", .pin_cpu = -1},
+        {.name = "Process (pipe)", .pin_cpu = cpu},
+        {.name = "Process (pipe)", .pin_cpu = -1}
+    };
+    for (int i = 0; i < PROBE_COUNT; i++) {
+        probe_context_switch(&probes[i], i >= 2, iterations);
+    }
+    print_switch_report(probes);
+
+    // The simulated tasks are processes sharing a CPU: the pinned pipe
+    // median is what one of their switches costs
+    const SwitchProbe* process = probes[2].ok ? &probes[2] : &probes[3];
+    const SwitchProbe* thread = probes[0].ok ? &probes[0] : &probes[1];
+    if (!process->ok || !thread->ok) {
+        fprintf(stderr, "probe: no usable context-switch measurement\n");
+        return -1;
+    }
+    profile->context_switch_ms = hist_percentile(&process->handoff, 50.0) / 1e6;
+    profile->thread_switch_ms = hist_percentile(&thread->handoff, 50.0) / 1e6;
+    profile->measured |= HOST_MEASURED_SWITCH;
+
+    printf("\nSimulated Switch Cost:   %.6f ms (reference %.3f ms)\n", profile->context_switch_ms, CONTEXT_SWITCH_LINUX);
+    printf("Context Switch Time:     %.3f ms vs < 0.010 ms -> %s\n",
+           profile->context_switch_ms, profile->context_switch_ms <= 0.010 ? "PASS" : "FAIL");
+    return 0;
+}
+
+void print_latency_row(const char* label, const Histogram* h) {
+    printf("| %-8s | %-10llu | %-9.3f | %-9.3f | %-9.3f | %-9.3f | %-9.3f | %-9.3f |\n",
+           label, (unsigned long long)h->count,
+           probe_us(h->min), hist_mean(h) / 1000.0,
+           probe_us(hist_percentile(h, 50.0)),
+           probe_us(hist_percentile(h, 99.0)),
+           probe_us(hist_percentile(h, 99.9)),
+           probe_us(h->max));
+}
+
+// Returns 0 and updates profile, -1 if no CPU completed
+int run_jitter_probe(const JitterConfig* config, HostProfile* profile) {
+    int cpus[PROBE_MAX_CPUS];
+    int ncpus = probe_allowed_cpus(cpus, PROBE_MAX_CPUS);
+    if (ncpus == 0) {
+        fprintf(stderr, "probe: cannot read the CPU affinity mask\n");
+        return -1;
+    }
+    JitterProbe* probes = (JitterProbe*)calloc(ncpus, sizeof(JitterProbe));
+    Histogram* total = (Histogram*)malloc(sizeof(Histogram));
+    if (probes == NULL || total == NULL) {
+        perror("probe: calloc failed");
+        exit(1);
+    }
+
+    printf("\nMeasuring wake-up latency: %d CPU%s, %s every %lld us, %d batch thread%s per CPU, %.1f s...\n",
+           ncpus, ncpus == 1 ? "" : "s", config->use_timerfd ? "timerfd" : "clock_nanosleep",
+           config->interval_ns / 1000, config->load_per_cpu, config->load_per_cpu == 1 ? "" : "s",
+           config->loops * config->interval_ns / 1e9);
+    fflush(stdout);
+    int completed = probe_wakeup_latency(config, cpus, ncpus, probes, total);
+
+    printf("\n================================================================================\n");
+    printf("WAKE-UP LATENCY (us past each periodic deadline)\n");
+    printf("================================================================================\n");
+    printf("\n+----------+------------+-----------+-----------+-----------+-----------+-----------+-----------+\n");
+    printf("| CPU      | Samples    | Min       | Avg       | P50       | P99       | P99.9     | Max       |\n");
+    printf("+----------+------------+-----------+-----------+-----------+-----------+-----------+-----------+\n");
+    int fifo = 0;
+    for (int c = 0; c < ncpus; c++) {
+        char label[16];
+        snprintf(label, sizeof(label), "%d", probes[c].cpu);
+        if (probes[c].ok) {
+            print_latency_row(label, &probes[c].latency);
+            fifo += probes[c].fifo;
+        } else {
+            printf("| %-8s | %-10s | %-9s | %-9s | %-9s | %-9s | %-9s | %-9s |\n",
+                   label, "failed", "-", "-", "-", "-", "-", "-");
+        }
+    }
+    if (ncpus > 1 && completed > 0) {
+        printf("+----------+------------+-----------+-----------+-----------+-----------+-----------+-----------+\n");
+        print_latency_row("All", total);
+    }
+    printf("+----------+------------+-----------+-----------+-----------+-----------+-----------+-----------+\n");
+    if (config->fifo_priority > 0 && fifo < completed) {
+        printf("Note: SCHED_FIFO was refused on %d of %d CPUs; those measured under the normal policy.\n",
+               completed - fifo, completed);
+    }
+
+    int status = -1;
+    if (completed > 0) {
+        printf("\nAll CPUs:\n");
+        hist_print_distribution(total, "  ");
+
+        // Latency of a typical-bad wake-up, and how far the tail strays from
+        // the typical one
+        uint64_t p50 = hist_percentile(total, 50.0);
+        uint64_t p99 = hist_percentile(total, 99.0);
+        uint64_t p999 = hist_percentile(total, 99.9);
+        profile->interrupt_latency_ms = p99 / 1e6;
+        profile->scheduling_jitter_ms = (p999 > p50 ? p999 - p50 : 1) / 1e6;
+        profile->measured |= HOST_MEASURED_LATENCY | HOST_MEASURED_JITTER;
+
+        printf("\nInterrupt Latency:       %.3f ms (p99 wake-up) vs < 0.100 ms -> %s\n",
+               profile->interrupt_latency_ms, profile->interrupt_latency_ms < 0.100 ? "PASS" : "FAIL");
+        printf("Scheduling Jitter:       %.4f ms (p99.9 - p50) vs < 2.000 ms -> %s\n",
+               profile->scheduling_jitter_ms, profile->scheduling_jitter_ms < 2.000 ? "PASS" : "FAIL");
+        status = 0;
+    } else {
+        fprintf(stderr, "probe: no usable wake-up latency measurement\n");
+    }
+    free(probes);
+    free(total);
+    return status;
+}
+
+// Comma-separated positive integers into out[]; returns the count, -1 if bad
+int parse_size_list(const char* list, long long minimum, long long* out, int max) {
+    int count = 0;
+    const char* p = list;
+    while (*p) {
+        char* end;
+        long long v = strtoll(p, &end, 10);
+        if (end == p || v < minimum || count == max || (*end != ',' && *end != '\0')) return -1;
+        out[count++] = v;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return count;
+}
+
+// Returns 0 and updates profile, -1 if no transport could be measured
+int run_ipc_probe(const IpcSweep* sweep, HostProfile* profile) {
+    int points = IPC_TRANSPORT_COUNT * sweep->nsizes * sweep->nbatches;
+    IpcResult* results = (IpcResult*)calloc(points, sizeof(IpcResult));
+    if (results == NULL) {
+        perror("probe: calloc failed");
+        exit(1);
+    }
+    printf("\nMeasuring IPC: %d transports x %d message sizes x %d batch sizes, up to %lld MB per point...\n",
+           IPC_TRANSPORT_COUNT, sweep->nsizes, sweep->nbatches, sweep->megabytes);
+    fflush(stdout);
+
+    int n = 0;
+    for (int t = 0; t < IPC_TRANSPORT_COUNT; t++) {
+        for (int s = 0; s < sweep->nsizes; s++) {
+            long long messages = sweep->megabytes * (1 << 20) / (long long)sweep->sizes[s];
+            if (messages > sweep->max_messages) messages = sweep->max_messages;
+            if (messages < 1) messages = 1;
+            uint64_t p50 = 0;
+            uint64_t p99 = 0;
+            for (int b = 0; b < sweep->nbatches; b++) {
+                IpcResult* r = &results[n++];
+                r->kind = t;
+                r->message = sweep->sizes[s];
+                r->batch = sweep->batches[b];
+                ipc_measure_throughput(r, messages);
+                // Latency depends on the message size only: measure it once
+                if (b == 0 && ipc_measure_latency(r, sweep->latency_rounds) == 0) {
+                    p50 = r->latency_p50;
+                    p99 = r->latency_p99;
+                }
+                r->latency_p50 = p50;
+                r->latency_p99 = p99;
+            }
+        }
+    }
+
+    printf("\n================================================================================\n");
+    printf("IPC THROUGHPUT AND LATENCY (MB = 2^20 bytes, latency one-way in us)\n");
+    printf("================================================================================\n");
+    printf("\n+----------------+----------+--------+------------+--------------+------------+------------+\n");
+    printf("| Transport      | Msg (B)  | Batch  | MB/s       | Msgs/s       | Lat P50    | Lat P99    |\n");
+    printf("+----------------+----------+--------+------------+--------------+------------+------------+\n");
+    const IpcResult* best = NULL;
+    for (int i = 0; i < points; i++) {
+        const IpcResult* r = &results[i];
+        if (i > 0 && r->kind != results[i - 1].kind) {
+            printf("+----------------+----------+--------+------------+--------------+------------+------------+\n");
+        }
+        char p50[16] = "-";
+        char p99[16] = "-";
+        if (r->latency_p50 > 0) {
+            snprintf(p50, sizeof(p50), "%.3f", probe_us(r->latency_p50));
+            snprintf(p99, sizeof(p99), "%.3f", probe_us(r->latency_p99));
+        }
+        if (!r->ok) {
+            printf("| %-14s | %-8zu | %-6d | %-10s | %-12s | %-10s | %-10s |\n",
+                   ipc_transport_names[r->kind], r->message, r->batch, "failed", "-", p50, p99);
+            continue;
+        }
+        printf("| %-14s | %-8zu | %-6d | %-10.1f | %-12.0f | %-10s | %-10s |\n",
+               ipc_transport_names[r->kind], r->message, r->batch, r->mbps, r->messages_per_s, p50, p99);
+        if (best == NULL || r->mbps > best->mbps) best = r;
+    }
+    printf("+----------------+----------+--------+------------+--------------+------------+------------+\n");
+
+    if (sweep->csv_path != NULL) {
+        FILE* csv = fopen(sweep->csv_path, "w");
+        if (csv == NULL) {
+            perror("probe: cannot write CSV");
+        } else {
+            fprintf(csv, "transport,message_bytes,batch,messages,seconds,mb_per_s,messages_per_s,latency_p50_us,latency_p99_us,ok\n");
+            for (int i = 0; i < points; i++) {
+                const IpcResult* r = &results[i];
+                fprintf(csv, "%s,%zu,%d,%lld,%.6f,%.3f,%.1f,%.3f,%.3f,%d\n",
+                        ipc_transport_names[r->kind], r->message, r->batch, r->messages, r->seconds,
+                        r->mbps, r->messages_per_s, probe_us(r->latency_p50), probe_us(r->latency_p99), r->ok);
+            }
+            fclose(csv);
+            printf("IPC Sweep CSV:           %s\n", sweep->csv_path);
+        }
+    }
+
+    int status = -1;
+    if (best != NULL) {
+        // The threshold asks what the host can move between POS and LPUS:
+        // the best sustained configuration
+        profile->ipc_throughput_mbps = best->mbps;
+        profile->measured |= HOST_MEASURED_IPC;
+        printf("\nIPC Throughput:          %.0f MB/s (%s, %zu B x %d) vs > 500 MB/s -> %s\n",
+               best->mbps, ipc_transport_names[best->kind], best->message, best->batch,
+               best->mbps > 500.0 ? "PASS" : "FAIL");
+        status = 0;
+    } else {
+        fprintf(stderr, "probe: no usable IPC measurement\n");
+    }
+    free(results);
+    return status;
+}
+
+int main(int argc, char** argv) {
+    int run_switch = 0;
+    int run_jitter = 0;
+    int run_ipc = 0;
+    int iterations = 20000;
+    double duration_s = 5.0;
+    JitterConfig jitter = { 1000 * 1000LL, 0, 0, 0, 0 };
+    IpcSweep ipc = { {64, 512, 4096, 65536}, 4, {1, 16}, 2, 64, 200000, 5000, NULL };
+    long long list[IPC_MAX_SWEEP];
+    const char* output = "primecart_host.profile";
+    int save = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--switch") == 0) {
+            run_switch = 1;
+        } else if (strcmp(argv[i], "--jitter") == 0) {
+            run_jitter = 1;
+        } else if (strcmp(argv[i], "--ipc") == 0) {
+            run_ipc = 1;
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc && atof(argv[i + 1]) >= 10) {
+            jitter.interval_ns = (long long)(atof(argv[++i]) * 1000);
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc && atof(argv[i + 1]) > 0) {
+            duration_s = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc && atoi(argv[i + 1]) >= 0) {
+            jitter.load_per_cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--timer") == 0 && i + 1 < argc
+                   && (strcmp(argv[i + 1], "nanosleep") == 0 || strcmp(argv[i + 1], "timerfd") == 0)) {
+            jitter.use_timerfd = strcmp(argv[++i], "timerfd") == 0;
+        } else if (strcmp(argv[i], "--fifo") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            jitter.fifo_priority = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc
+                   && (ipc.nsizes = parse_size_list(argv[i + 1], IPC_MIN_MESSAGE, list, IPC_MAX_SWEEP)) > 0) {
+            for (int k = 0; k < ipc.nsizes; k++) ipc.sizes[k] = (size_t)list[k];
+            i++;
+        } else if (strcmp(argv[i], "--batches") == 0 && i + 1 < argc
+                   && (ipc.nbatches = parse_size_list(argv[i + 1], 1, list, IPC_MAX_SWEEP)) > 0) {
+            for (int k = 0; k < ipc.nbatches; k++) ipc.batches[k] = (int)list[k];
+            i++;
+        } else if (strcmp(argv[i], "--megabytes") == 0 && i + 1 < argc && atoll(argv[i + 1]) > 0) {
+            ipc.megabytes = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            ipc.csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--no-save") == 0) {
+            save = 0;
+        } else {
+            print_probe_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!run_switch && !run_jitter && !run_ipc) {
+        run_switch = 1;
+        run_jitter = 1;
+        run_ipc = 1;
+    }
+    jitter.loops = (long long)(duration_s * 1e9 / jitter.interval_ns);
+    if (jitter.loops < 1) jitter.loops = 1;
+
+    // Figures this run does not measure keep what the profile already holds
+    HostProfile profile = sim_host;
+    if (save && access(output, F_OK) == 0 && host_profile_load(&profile, output) != 0) {
+        return 1;
+    }
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX HOST PROBE\n");
+    printf("%ld Online CPU%s", online, online == 1 ? "" : "s");
+    if (run_switch) printf(" | %d Round Trips per Switch Probe (+%d warm-up)", iterations, PROBE_WARMUP_ROUNDS);
+    printf("\n================================================================================\n");
+
+    int failed = 0;
+    if (run_switch) {
+        if (online == 1) {
+            printf("Note: with one CPU the unpinned pairs share it too, so they match the pinned ones.\n");
+        }
+        failed |= run_switch_probe(iterations, &profile) != 0;
+    }
+    if (run_jitter) {
+        failed |= run_jitter_probe(&jitter, &profile) != 0;
+    }
+    if (run_ipc) {
+        failed |= run_ipc_probe(&ipc, &profile) != 0;
+    }
+
+    if (save && profile.measured != 0) {
+        gethostname(profile.host, sizeof(profile.host) - 1);
+        time_t now = time(NULL);
+        strftime(profile.date, sizeof(profile.date), "%Y-%m-%d %H:%M", localtime(&now));
+        if (host_profile_save(&profile, output) != 0) return 1;
+        printf("\nHost Profile:            %s (use with --host-profile)\n", output);
+    }
+    return failed;
+}
@@ -5,401 +5,98 @@
 #include <unistd.h>
 #include <time.h>
 
-#define CONTEXT_SWITCH_LINUX 0.004
-#define INTERRUPT_LATENCY_LINUX 0.075  
-#define SCHEDULING_JITTER_LINUX 0.0005 
-#define IPC_THROUGHPUT_LINUX 950.0    
-#define TIME_QUANTUM 5
-#define MAX_PROCESSES 7
+#include "primecart_parallel.h"
 
-typedef struct {
-    char pid[4];
-    char description[50];
-    char process_type[12];
-    int arrival_time;
-    int burst_time;
-    int remaining_time;
-    int priority;
-    int start_time;
-    int exit_time;
-    int waiting_time;
-    int turnaround_time;
-    int response_time;
-    int completed;
-    int context_switches;
-} LinuxProcess;
-
-LinuxProcess processes[] = {
-    {"P1", "LPUS Batch Update: SQL DB Write", "Background", 0, 20, 20, 4, -1, 0, 0, 0, -1, 0, 0},
-    {"P2", "POS Scan Validation: Barcode Check", "Foreground", 1, 6, 6, 1, -1, 0, 0, 0, -1, 0, 0},
-    {"P3", "POS Price Lookup: GUI Display", "Foreground", 2, 4, 4, 1, -1, 0, 0, 0, -1, 0, 0},
-    {"P4", "LPUS Inventory Sync: Stock Upload", "Background", 4, 12, 12, 4, -1, 0, 0, 0, -1, 0, 0},
-    {"P5", "POS Payment Auth: Data Encryption", "Foreground", 5, 8, 8, 2, -1, 0, 0, 0, -1, 0, 0},
-    {"P6", "LPUS Metadata Refresh: Cache Update", "Background", 7, 10, 10, 5, -1, 0, 0, 0, -1, 0, 0},
-    {"P7", "POS Receipt Gen: Log Transaction", "Foreground", 9, 4, 4, 1, -1, 0, 0, 0, -1, 0, 0}
-};
-
-#define NUM_PROCESSES (sizeof(processes)/sizeof(processes[0]))
+double rr_quantum_ms = TIME_QUANTUM; // --quantum
 
-typedef struct Node {
-    int process_index;
-    struct Node* next;
-} Node;
-
-typedef struct {
-    Node* front;
-    Node* rear;
-    int size;
-} Queue;
+// Quantum sweep (--sweep): find the quantum with the lowest p99 POS
+// response whose CPU load (work plus switch overhead) stays under a ceiling
+int sweep_mode = 0;
+double sweep_min_ms = 1.0;
+double sweep_max_ms = 50.0;
+double sweep_ceiling = 75.0;   // %, the PrimeCart CPU utilization threshold
+int sweep_jobs = 0;            // worker threads, 0 = online CPUs
 
-Queue* create_queue() {
-    Queue* q = (Queue*)malloc(sizeof(Queue));
-    q->front = q->rear = NULL;
-    q->size = 0;
-    return q;
-}
-
-void enqueue(Queue* q, int process_index) {
-    Node* new_node = (Node*)malloc(sizeof(Node));
-    new_node->process_index = process_index;
-    new_node->next = NULL;
-    
-    if (q->rear == NULL) {
-        q->front = q->rear = new_node;
-    } else {
-        q->rear->next = new_node;
-        q->rear = new_node;
+void rr_on_dispatch(SchedSim* sim, int task, int first_run) {
+    if (first_run) {
+        LinuxProcess* p = &sim->procs[task];
+        printf("[Time %.3fms] %s started (Response Time: %.3fms)\n", 
+               sim_ms(sim->current_time), p->pid, sim_ms(p->response_time));
     }
-    q->size++;
 }
 
-int dequeue(Queue* q) {
-    if (q->front == NULL) return -1;
-    
-    Node* temp = q->front;
-    int process_index = temp->process_index;
-    q->front = q->front->next;
-    
-    if (q->front == NULL) {
-        q->rear = NULL;
-    }
-    
-    free(temp);
-    q->size--;
-    return process_index;
+void rr_on_preempt(SchedSim* sim, int task, int next, int reason) {
+    (void)next;
+    (void)reason;
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s preempted (%gms remaining)\n",
+           sim_ms(sim->current_time), p->pid, sim_ms(p->remaining_time));
 }
 
-int is_queue_empty(Queue* q) {
-    return q->front == NULL;
+void rr_on_complete(SchedSim* sim, int task) {
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s completed\n", sim_ms(sim->current_time), p->pid);
+    printf("      Turnaround: %.3fms, Waiting: %.3fms\n\n",
+           sim_ms(p->turnaround_time),
+           sim_ms(p->waiting_time));
 }
 
-void print_gantt_chart(int *gantt_pid, int *gantt_start, int *gantt_end, int gantt_size) {
-    printf("\n================================================================================\n");
-    printf("GANTT CHART - ROUND ROBIN SCHEDULING (5ms Quantum)\n");
-    printf("================================================================================\n\n");
-    
-    // First group consecutive executions of same process
-    int grouped_pid[50];
-    int grouped_start[50];
-    int grouped_end[50];
-    int grouped_size = 0;
-    
-    for (int i = 0; i < gantt_size; i++) {
-        if (i == 0 || gantt_pid[i] != gantt_pid[i-1]) {
-            grouped_pid[grouped_size] = gantt_pid[i];
-            grouped_start[grouped_size] = gantt_start[i];
-            grouped_end[grouped_size] = gantt_end[i];
-            grouped_size++;
-        } else {
-            grouped_end[grouped_size-1] = gantt_end[i];
-        }
-    }
-    
-    // Print timeline header
-    printf("Time(ms) ");
-    for (int i = 0; i < grouped_size; i++) {
-        printf("|");
-        int duration = grouped_end[i] - grouped_start[i];
-        int scaled_length = duration;  // Scale factor
-        
-        for (int j = 0; j < scaled_length; j++) {
-            printf("-");
-        }
-    }
-    printf("|\n");
-    
-    // Print process labels
-    printf("         ");
-    for (int i = 0; i < grouped_size; i++) {
-        printf("|");
-        int duration = grouped_end[i] - grouped_start[i];
-        int scaled_length = duration;
-        
-        // Center PID in block
-        if (scaled_length >= 3) {
-            int padding = (scaled_length - 2) / 2;
-            for (int j = 0; j < padding; j++) printf(" ");
-            printf("%s", processes[grouped_pid[i]].pid);
-            for (int j = 0; j < scaled_length - 2 - padding; j++) printf(" ");
-        } else {
-            printf("%-*s", scaled_length, processes[grouped_pid[i]].pid);
-        }
-    }
-    printf("|\n");
-    
-    // Print time markers
-    printf("        0");
-    int cumulative = 0;
-    for (int i = 0; i < grouped_size; i++) {
-        cumulative += (grouped_end[i] - grouped_start[i]);
-        int duration = grouped_end[i] - grouped_start[i];
-        int scaled_length = duration;
-        
-        int spacing = scaled_length + 1;
-        printf("%*d", spacing, cumulative);
-    }
-    printf("\n");
-    
-    // Clean execution sequence
-    printf("\nExecution Sequence: ");
-    for (int i = 0; i < grouped_size; i++) {
-        printf("%s", processes[grouped_pid[i]].pid);
-        if (i < grouped_size - 1) {
-            printf(" -> ");
-        }
-    }
-    printf("\n");
-    
-    printf("\nNote: Each '-' character represents 1ms of execution time\n");
-    printf("      Consecutive executions grouped together\n");
-}
-
-void run_linux_rr_analysis() {
+void run_linux_rr_analysis(const SimOptions* options, const Workload* workload) {
     printf("================================================================================\n");
     printf("PRIMECART RETAIL - LINUX LPUS BACKEND ROUND ROBIN ANALYSIS\n");
-    printf("Ubuntu 22.04 LTS Server | Preemptive Round Robin (Quantum: 5ms)\n");
+    printf("Ubuntu 22.04 LTS Server | Preemptive Round Robin (Quantum: %gms)\n", rr_quantum_ms);
+    printf("Workload: %s (%zu processes)\n", workload->name, workload->count);
     printf("================================================================================\n");
     
-    // Print Process Table
-    printf("\nPROCESS TABLE (Sorted by Arrival Time):\n");
-    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
-    printf("| PID | Task Description                 | Type         | Arrival  | Burst    | Priority |\n");
-    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
-    
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("| %-3s | %-32s | %-12s | %-8d | %-8d | %-8d |\n",
-               processes[i].pid,
-               processes[i].description,
-               processes[i].process_type,
-               processes[i].arrival_time,
-               processes[i].burst_time,
-               processes[i].priority);
-    }
-    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
+    SchedPolicy policy = RR_POLICY;
+    policy.quantum = MS_TO_NS(rr_quantum_ms);
+    SchedSim sim;
+    sim_init(&sim, &policy, workload);
+    sim_apply_options(&sim, options);
     
-    // Initialize variables
-    Queue* ready_queue = create_queue();
-    int current_time = 0;
-    int completed_count = 0;
-    int total_waiting_time = 0;
-    int total_turnaround_time = 0;
-    int total_response_time = 0;
-    int total_burst_time = 0;
-    int total_context_switches = 0;
-    int total_idle_time = 0;
-    
-    // Arrays for Gantt chart
-    int gantt_pid[100];
-    int gantt_start[100];
-    int gantt_end[100];
-    int gantt_index = 0;
-    
-    printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
-    printf("================================================================================\n\n");
-    
-    // Main scheduling loop
-    while (completed_count < NUM_PROCESSES) {
-        // Add newly arrived processes to ready queue
-        for (int i = 0; i < NUM_PROCESSES; i++) {
-            if (!processes[i].completed && 
-                processes[i].arrival_time <= current_time && 
-                processes[i].remaining_time > 0) {
-                
-                int in_queue = 0;
-                Node* current = ready_queue->front;
-                while (current != NULL) {
-                    if (current->process_index == i) {
-                        in_queue = 1;
-                        break;
-                    }
-                    current = current->next;
-                }
-                
-                if (!in_queue) {
-                    enqueue(ready_queue, i);
-                }
-            }
-        }
-        
-        // If ready queue is empty, advance time
-        if (is_queue_empty(ready_queue)) {
-            current_time++;
-            total_idle_time++;
-            continue;
-        }
-        
-        // Get next process from ready queue
-        int current_process = dequeue(ready_queue);
-        
-        // Record start time if this is first execution
-        if (processes[current_process].start_time == -1) {
-            processes[current_process].start_time = current_time;
-            processes[current_process].response_time = current_time - processes[current_process].arrival_time;
-            printf("[Time %dms] %s started (Response Time: %dms)\n", 
-                   current_time, processes[current_process].pid, processes[current_process].response_time);
-        }
-        
-        // Determine execution time
-        int execution_time = (processes[current_process].remaining_time < TIME_QUANTUM) ? 
-                             processes[current_process].remaining_time : TIME_QUANTUM;
-        
-        // Record Gantt chart entry - FIXED: no +1
-        gantt_pid[gantt_index] = current_process;
-        gantt_start[gantt_index] = current_time;
-        gantt_end[gantt_index] = current_time + execution_time;
-        gantt_index++;
+    if (options->quiet) {
+        sim_run(&sim, NULL);
+    } else {
+        // Print Process Table
+        sim_print_process_table(workload, "PROCESS TABLE (Sorted by Arrival Time):");
         
-        // Update process state (simulated execution)
-        processes[current_process].remaining_time -= execution_time;
-        current_time += execution_time;
+        printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
+        printf("================================================================================\n\n");
         
-        // Check if completed
-        if (processes[current_process].remaining_time == 0) {
-            processes[current_process].completed = 1;
-            processes[current_process].exit_time = current_time;
-            processes[current_process].turnaround_time = current_time - processes[current_process].arrival_time;
-            processes[current_process].waiting_time = processes[current_process].turnaround_time - processes[current_process].burst_time;
-            
-            completed_count++;
-            
-            printf("[Time %dms] %s completed\n", current_time, processes[current_process].pid);
-            printf("      Turnaround: %dms, Waiting: %dms\n\n",
-                   processes[current_process].turnaround_time,
-                   processes[current_process].waiting_time);
-            
-            total_waiting_time += processes[current_process].waiting_time;
-            total_turnaround_time += processes[current_process].turnaround_time;
-            total_response_time += processes[current_process].response_time;
-            total_burst_time += processes[current_process].burst_time;
-        } else {
-            // Process preempted
-            printf("[Time %dms] %s preempted (%dms remaining)\n",
-                   current_time, processes[current_process].pid, processes[current_process].remaining_time);
-            
-            enqueue(ready_queue, current_process);
-            processes[current_process].context_switches++;
-            total_context_switches++;
-        }
+        // Main scheduling loop
+        SchedHooks hooks = { rr_on_dispatch, rr_on_preempt, rr_on_complete };
+        sim_run(&sim, &hooks);
         
-        // Add context switch overhead
-        if (completed_count < NUM_PROCESSES && !is_queue_empty(ready_queue)) {
-            current_time += CONTEXT_SWITCH_LINUX;
-        }
+        // Print Gantt Chart
+        char title[64];
+        snprintf(title, sizeof(title), "ROUND ROBIN SCHEDULING (%gms Quantum)", sim_ms(sim.policy->quantum));
+        sim_print_gantt(&sim, title, 1);
     }
     
-    // Print Gantt Chart
-    print_gantt_chart(gantt_pid, gantt_start, gantt_end, gantt_index);
-    
-    // Calculate averages
-    float avg_waiting_time = total_waiting_time / (float)NUM_PROCESSES;
-    float avg_turnaround_time = total_turnaround_time / (float)NUM_PROCESSES;
-    float avg_response_time = total_response_time / (float)NUM_PROCESSES;
-    
-    // Calculate CPU utilization
-    int total_execution_time = current_time;
-    float cpu_utilization = (total_burst_time * 100.0) / total_execution_time;
-    
-    // Print System-Wide Performance Metrics
-    printf("\n================================================================================\n");
-    printf("SYSTEM-WIDE PERFORMANCE METRICS (Round Robin Scheduling)\n");
-    printf("================================================================================\n");
-    
-    printf("\nAverage Waiting Time:    %.2f ms\n", avg_waiting_time);
-    printf("Average Response Time:   %.2f ms\n", avg_response_time);
-    printf("Average Turnaround Time: %.2f ms\n", avg_turnaround_time);
-    printf("CPU Utilization:         %.1f%%\n", cpu_utilization);
-    printf("Total Context Switches:  %d\n", total_context_switches);
-    printf("Context Switch Overhead: %.3f ms\n", total_context_switches * CONTEXT_SWITCH_LINUX);
-    printf("Total Execution Time:    %d ms\n", total_execution_time);
-    printf("Total CPU Busy Time:     %d ms\n", total_burst_time);
-    printf("Total Idle Time:         %d ms\n", total_idle_time);
-    
-    // Performance Analysis Table
-    printf("\n================================================================================\n");
-    printf("PROCESS PERFORMANCE METRICS (Round Robin Execution)\n");
-    printf("================================================================================\n");
-    
-    printf("\n+-----+----------+----------+----------+----------+----------+------------+------------+\n");
-    printf("| PID | Arrival  | Burst    | Start    | Exit     | Response | Wait       | Turnaround |\n");
-    printf("+-----+----------+----------+----------+----------+----------+------------+------------+\n");
+    sim_print_system_metrics(&sim, " (Round Robin Scheduling)");
+    sim_print_tail_latency(&sim, " (POS vs LPUS under Round Robin)");
     
-    for (int i = 0; i < NUM_PROCESSES; i++) {
-        printf("| %-3s | %-8d | %-8d | %-8d | %-8d | %-8d | %-10d | %-10d |\n",
-               processes[i].pid,
-               processes[i].arrival_time,
-               processes[i].burst_time,
-               processes[i].start_time,
-               processes[i].exit_time,
-               processes[i].response_time,
-               processes[i].waiting_time,
-               processes[i].turnaround_time);
+    if (!options->quiet) {
+        sim_print_process_metrics(&sim, " (Round Robin Execution)", NULL, sim.count);
     }
-    printf("+-----+----------+----------+----------+----------+----------+------------+------------+\n");
     
-    // PrimeCart Threshold Analysis - FIXED FORMAT
-    printf("\n================================================================================\n");
-    printf("PRIMECART THRESHOLD ANALYSIS (Ubuntu 22.04 LTS Server - Round Robin)\n");
-    printf("================================================================================\n");
-    printf("Metric                 Target Threshold    Linux Value     Status   Why It Matters for PrimeCart\n");
-    printf("--------------------------------------------------------------------------------\n");
+    // PrimeCart Threshold Analysis
+    const char* const why[5] = {
+        "Faster interrupt handling for POS devices",
+        "Stable backend processing",
+        "Efficient context switching keeps POS transactions responsive under load.",
+        "Leaves insufficient headroom for peak traffic",
+        "Fast POS-backend communication via shared memory"
+    };
+    sim_print_threshold_analysis(&sim, " - Round Robin", why);
     
-    // Interrupt Latency
-    const char* int_status = INTERRUPT_LATENCY_LINUX < 0.100 ? "PASS" : "FAIL";
-    printf("Interrupt Latency      < 0.100 ms          %-12s %-6s   Faster interrupt handling for POS devices\n", 
-           "0.075 ms", int_status);
-    
-    // Scheduling Jitter
-    const char* jitter_status = SCHEDULING_JITTER_LINUX < 2.000 ? "PASS" : "FAIL";
-    printf("Scheduling Jitter      < 2.000 ms          %-12s %-6s   Stable backend processing\n", 
-           "0.001 ms", jitter_status);
-    
-    // Context Switch Time
-    const char* cs_status = CONTEXT_SWITCH_LINUX <= 0.010 ? "PASS" : "FAIL";
-    printf("Context Switch Time    < 0.010 ms          %-12s %-6s   Efficient context switching keeps POS transactions responsive under load.\n", 
-           "0.004 ms", cs_status);
-    
-    // CPU Utilization - FIXED: Changed from >90.0% to <75.0% for consistency
-    const char* cpu_status = cpu_utilization < 75.0 ? "PASS" : "FAIL";
-    char cpu_value[20];
-    sprintf(cpu_value, "%.1f%%", cpu_utilization);
-    printf("CPU Utilization        < 75.0%%             %-12s %-6s   Leaves insufficient headroom for peak traffic\n", 
-           cpu_value, cpu_status);  // CHANGED THRESHOLD AND EXPLANATION
-    
-    // IPC Throughput
-    const char* ipc_status = IPC_THROUGHPUT_LINUX > 500.0 ? "PASS" : "FAIL";
-    char ipc_value[20];
-    sprintf(ipc_value, "%.0f MB/s", IPC_THROUGHPUT_LINUX);
-    printf("IPC Throughput         > 500 MB/s          %-12s %-6s   Fast POS-backend communication via shared memory\n", 
-           ipc_value, ipc_status);
-    
-    printf("--------------------------------------------------------------------------------\n");    
     // Round Robin Algorithm Analysis
     printf("\n================================================================================\n");
     printf("ROUND ROBIN ALGORITHM ANALYSIS\n");
     printf("================================================================================\n");
     
     printf("\nRR Selection Logic:\n");
-    printf("• Each process gets equal 5ms CPU quantum\n");
+    printf("• Each process gets equal %gms CPU quantum\n", rr_quantum_ms);
     printf("• Preempted processes return to end of ready queue\n");
     printf("• New arrivals appended to queue\n");
     printf("• Guarantees maximum waiting time bounded by (n-1)*q\n");
@@ -416,10 +113,255 @@ void run_linux_rr_analysis() {
     printf("ANALYSIS COMPLETE\n");
     printf("================================================================================\n");
     
-    free(ready_queue);
+    sim_free(&sim);
+}
+
+
+// ---------------------------------------------------------------------------
+// Quantum sweep
+// ---------------------------------------------------------------------------
+
+#define SWEEP_REFINE_STEPS 4 // fine points per coarse gap around the optimum
+
+typedef struct {
+    const SimOptions* options;
+    const Workload* workload;      // shared, read-only
+    double* quantum_ms;            // grown by sweep_add between passes
+    SimSummary* results;
+    int count;
+    int capacity;
+    int done;                      // points already simulated
+} QuantumSweep;
+
+void sweep_job(void* ctx, int index) {
+    QuantumSweep* sweep = (QuantumSweep*)ctx;
+    int point = sweep->done + index;
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    // Each run gets its own copy of the policy with its quantum
+    SchedPolicy policy = RR_POLICY;
+    policy.quantum = MS_TO_NS(sweep->quantum_ms[point]);
+    SchedSim sim;
+    sim_init(&sim, &policy, sweep->workload);
+    sim_apply_options(&sim, sweep->options);
+    sim_enable_streaming(&sim); // only the summary is needed
+    sim_run(&sim, NULL);
+    sim_summarize(&sim, &sweep->results[point]);
+    sim_free(&sim);
+
+    sweep->results[point].wall_seconds = parallel_elapsed(&started);
+}
+
+void sweep_add(QuantumSweep* sweep, double ms) {
+    for (int i = 0; i < sweep->count; i++) {
+        if (fabs(sweep->quantum_ms[i] - ms) < 1e-6) return;
+    }
+    if (sweep->count == sweep->capacity) {
+        int capacity = sweep->capacity ? sweep->capacity * 2 : 64;
+        double* quantum_ms = (double*)realloc(sweep->quantum_ms, sizeof(double) * capacity);
+        if (quantum_ms == NULL) {
+            perror("sweep: realloc failed");
+            exit(1);
+        }
+        sweep->quantum_ms = quantum_ms;
+        SimSummary* results = (SimSummary*)realloc(sweep->results, sizeof(SimSummary) * capacity);
+        if (results == NULL) {
+            perror("sweep: realloc failed");
+            exit(1);
+        }
+        sweep->results = results;
+        sweep->capacity = capacity;
+    }
+    sweep->quantum_ms[sweep->count++] = ms;
+}
+
+// Simulate the points added since the last call, all at once
+void sweep_run_pending(QuantumSweep* sweep, int jobs) {
+    parallel_run(sweep_job, sweep, sweep->count - sweep->done, jobs);
+    sweep->done = sweep->count;
+}
+
+// Lowest p99 POS response under the ceiling, -1 if no point qualifies
+int sweep_best(const QuantumSweep* sweep) {
+    int best = -1;
+    for (int i = 0; i < sweep->count; i++) {
+        const SimSummary* s = &sweep->results[i];
+        if (s->cpu_load > sweep_ceiling) continue;
+        if (best == -1 || s->p99_class_response[TASK_CLASS_FOREGROUND] <
+                          sweep->results[best].p99_class_response[TASK_CLASS_FOREGROUND]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void run_rr_quantum_sweep(const SimOptions* options, const Workload* workload) {
+    int jobs = sweep_jobs > 0 ? sweep_jobs : parallel_default_threads();
+    QuantumSweep* sweep = (QuantumSweep*)calloc(1, sizeof(QuantumSweep));
+    if (sweep == NULL) {
+        perror("sweep: calloc failed");
+        exit(1);
+    }
+    sweep->options = options;
+    sweep->workload = workload;
+
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX LPUS BACKEND ROUND ROBIN QUANTUM SWEEP\n");
+    printf("Ubuntu 22.04 LTS Server | Quantum %g-%gms, CPU Load Ceiling %.1f%%, %d Worker Thread%s\n",
+           sweep_min_ms, sweep_max_ms, sweep_ceiling, jobs, jobs == 1 ? "" : "s");
+    printf("Workload: %s (%zu processes)\n", workload->name, workload->count);
+    printf("================================================================================\n");
+
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    // Coarse pass: 1 ms steps up to 10 ms, 2 ms to 20 ms, then 5 ms
+    for (double q = sweep_min_ms; q < sweep_max_ms; q += q < 10 ? 1 : q < 20 ? 2 : 5) {
+        sweep_add(sweep, q);
+    }
+    sweep_add(sweep, sweep_max_ms);
+    sweep_run_pending(sweep, jobs);
+    int coarse = sweep->count;
+
+    // Fine pass: subdivide the gaps on either side of the coarse optimum
+    int best = sweep_best(sweep);
+    if (best != -1) {
+        double q = sweep->quantum_ms[best];
+        double below = sweep_min_ms;
+        double above = sweep_max_ms;
+        for (int i = 0; i < coarse; i++) {
+            double other = sweep->quantum_ms[i];
+            if (other < q && other > below) below = other;
+            if (other > q && other < above) above = other;
+        }
+        for (int step = 1; step < SWEEP_REFINE_STEPS; step++) {
+            sweep_add(sweep, below + (q - below) * step / SWEEP_REFINE_STEPS);
+            sweep_add(sweep, q + (above - q) * step / SWEEP_REFINE_STEPS);
+        }
+        sweep_run_pending(sweep, jobs);
+        best = sweep_best(sweep);
+    }
+    double wall = parallel_elapsed(&started);
+
+    // Print in quantum order (insertion sort: one simulation per point
+    // dwarfs it)
+    int* order = (int*)malloc(sizeof(int) * sweep->count);
+    if (order == NULL) {
+        perror("sweep: malloc failed");
+        exit(1);
+    }
+    for (int i = 0; i < sweep->count; i++) {
+        int k = i;
+        while (k > 0 && sweep->quantum_ms[order[k - 1]] > sweep->quantum_ms[i]) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = i;
+    }
+
+    printf("\n================================================================================\n");
+    printf("QUANTUM SWEEP (times in ms; * = optimum, - = over the CPU load ceiling)\n");
+    printf("================================================================================\n");
+    printf("\n+---+-----------+--------------+------------+------------+------------+-------------+----------+\n");
+    printf("|   | Quantum   | P99 POS Resp | Avg Resp   | P99 Resp   | Switches   | Switch (ms) | CPU Load |\n");
+    printf("+---+-----------+--------------+------------+------------+------------+-------------+----------+\n");
+    for (int k = 0; k < sweep->count; k++) {
+        int i = order[k];
+        const SimSummary* s = &sweep->results[i];
+        char mark = i == best ? '*' : s->cpu_load > sweep_ceiling ? '-' : ' ';
+        printf("| %c | %-9.3f | %-12.3f | %-10.3f | %-10.3f | %-10lld | %-11.3f | %7.2f%% |\n",
+               mark,
+               sweep->quantum_ms[i],
+               s->p99_class_response[TASK_CLASS_FOREGROUND],
+               s->avg_response,
+               s->p99_response,
+               s->context_switches,
+               s->switch_overhead,
+               s->cpu_load);
+    }
+    printf("+---+-----------+--------------+------------+------------+------------+-------------+----------+\n");
+
+    if (best == -1) {
+        printf("\nNo quantum in %g-%gms keeps the CPU load under %.1f%%\n", sweep_min_ms, sweep_max_ms, sweep_ceiling);
+    } else {
+        const SimSummary* s = &sweep->results[best];
+        printf("\nOptimal Quantum:         %.3f ms\n", sweep->quantum_ms[best]);
+        printf("P99 POS Response:        %.3f ms\n", s->p99_class_response[TASK_CLASS_FOREGROUND]);
+        printf("CPU Load:                %.2f%% (ceiling %.1f%%)\n", s->cpu_load, sweep_ceiling);
+        printf("Context Switches:        %lld\n", s->context_switches);
+    }
+    printf("Points Simulated:        %d (%d coarse, %d refined) in %.2f s\n",
+           sweep->count, coarse, sweep->count - coarse, wall);
+
+    free(order);
+    free(sweep->quantum_ms);
+    free(sweep->results);
+    free(sweep);
+}
+
+void print_rr_usage(void) {
+    fprintf(stderr, "Round Robin options:\n");
+    fprintf(stderr, "  --quantum MS         time quantum (default %d)\n", TIME_QUANTUM);
+    fprintf(stderr, "  --sweep              simulate a range of quanta in parallel and report the one\n");
+    fprintf(stderr, "                       with the lowest p99 POS response under the CPU load ceiling\n");
+    fprintf(stderr, "  --sweep-range MIN,MAX  quanta to sweep in ms (default 1,50)\n");
+    fprintf(stderr, "  --ceiling PCT        CPU load ceiling incl. switch overhead (default 75)\n");
+    fprintf(stderr, "  --jobs N             sweep worker threads (default: online CPUs)\n");
+}
+
+// Consume the Round Robin options and drop them from argv.
+// Returns the remaining argc, -1 on a bad option.
+int parse_rr_options(int argc, char** argv) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quantum") == 0 && i + 1 < argc) {
+            rr_quantum_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--sweep") == 0) {
+            sweep_mode = 1;
+        } else if (strcmp(argv[i], "--sweep-range") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lf,%lf", &sweep_min_ms, &sweep_max_ms) != 2) {
+                print_rr_usage();
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--ceiling") == 0 && i + 1 < argc) {
+            sweep_ceiling = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            sweep_jobs = atoi(argv[++i]);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    if (rr_quantum_ms <= 0 || sweep_min_ms <= 0 || sweep_max_ms < sweep_min_ms || sweep_jobs < 0) {
+        print_rr_usage();
+        return -1;
+    }
+    return kept;
 }
 
-int main() {
-    run_linux_rr_analysis();
+int main(int argc, char** argv) {
+    SimOptions options;
+    Workload workload;
+    argc = parse_rr_options(argc, argv);
+    if (argc < 0) return 1;
+    if (sim_parse_options(&options, argc, argv) != 0) {
+        print_rr_usage();
+        return 1;
+    }
+    if (sim_open_workload(&options, &workload) != 0) return 1;
+    
+    if (sweep_mode) {
+        if (options.trace_path != NULL || options.realtime) {
+            fprintf(stderr, "sweep: --trace and --realtime apply to a single run\n");
+            workload_free(&workload);
+            return 1;
+        }
+        workload_prepare_shared(&workload);
+        run_rr_quantum_sweep(&options, &workload);
+    } else {
+        run_linux_rr_analysis(&options, &workload);
+    }
+    
+    workload_free(&workload);
     return 0;
 }
@@ -0,0 +1,311 @@
+// primecart_linux_replicate.c
+// Monte Carlo replication: K independently generated workload instances,
+// every policy run on each, merged into means and 95% confidence intervals.
+//
+// Replication r draws its trace from stream r of the seed (counter-based,
+// see rng_seed_stream), so workers never share a generator and any single
+// replication can be reproduced on its own. All policies see the same K
+// instances, which makes their differences sharper than independent draws.
+//
+//   ./replicate --replications 50 --count 20000 --arrival mmpp --jobs 8
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "primecart_parallel.h"
+#include "primecart_generator.h"
+
+typedef struct {
+    const SimOptions* options;
+    GeneratorConfig config;
+    const SchedPolicy* policies[SIM_POLICY_COUNT];
+    int npolicies;
+    int replications;
+    SimSummary* results;      // [replication * npolicies + policy]
+    SimLatency* pooled;       // [policy], every replication's histograms merged
+    pthread_mutex_t lock;     // guards pooled
+} Replication;
+
+int replicate_next_record(void* ctx, WorkloadRecord* rec) {
+    return generator_next((Generator*)ctx, rec);
+}
+
+// One replication: every policy runs on the trace of stream index, fed
+// straight from a generator restarted per policy, so neither the trace nor
+// finished tasks are kept and memory does not grow with --count
+void replicate_job(void* ctx, int index) {
+    Replication* rep = (Replication*)ctx;
+    for (int p = 0; p < rep->npolicies; p++) {
+        struct timespec started;
+        clock_gettime(CLOCK_MONOTONIC, &started);
+        Generator gen;
+        generator_init_stream(&gen, &rep->config, (uint64_t)index);
+        SchedSim sim;
+        sim_init(&sim, rep->policies[p], NULL);
+        sim_set_source(&sim, replicate_next_record, &gen, "replication");
+        sim_apply_options(&sim, rep->options);
+        sim_enable_streaming(&sim);
+        sim_run(&sim, NULL);
+        SimSummary* s = &rep->results[index * rep->npolicies + p];
+        sim_summarize(&sim, s);
+        pthread_mutex_lock(&rep->lock);
+        sim_latency_merge(&rep->pooled[p], sim.latency);
+        pthread_mutex_unlock(&rep->lock);
+        sim_free(&sim);
+        s->wall_seconds = parallel_elapsed(&started);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Merging
+// ---------------------------------------------------------------------------
+
+#define REPLICATE_METRIC_COUNT 13
+
+const char* replicate_metric_names[REPLICATE_METRIC_COUNT] = {
+    "Avg Waiting Time (ms)",
+    "Avg Response Time (ms)",
+    "Avg Turnaround (ms)",
+    "P99 Waiting Time (ms)",
+    "P99 Response Time (ms)",
+    "P99 Turnaround (ms)",
+    "P99 POS Response (ms)",
+    "CPU Utilization (%)",
+    "Throughput (tasks/s)",
+    "Preemptions",
+    "Context Switches",
+    "Switch Overhead (ms)",
+    "Total Execution (ms)"
+};
+
+double replicate_metric(const SimSummary* s, int metric) {
+    switch (metric) {
+        case 0:  return s->avg_wait;
+        case 1:  return s->avg_response;
+        case 2:  return s->avg_turnaround;
+        case 3:  return s->p99_wait;
+        case 4:  return s->p99_response;
+        case 5:  return s->p99_turnaround;
+        case 6:  return s->p99_class_response[TASK_CLASS_FOREGROUND];
+        case 7:  return s->utilization;
+        case 8:  return s->throughput;
+        case 9:  return (double)s->preemptions;
+        case 10: return (double)s->context_switches;
+        case 11: return s->switch_overhead;
+        default: return s->makespan;
+    }
+}
+
+// Two-sided 95% Student t quantile for df degrees of freedom
+double student_t_95(int df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) return 0.0;
+    if (df <= 30) return table[df - 1];
+    return 1.960 + 2.4 / df; // within 0.002 of the exact value beyond 30
+}
+
+typedef struct {
+    double mean;
+    double stddev;            // sample standard deviation
+    double half_width;        // 95% confidence interval = mean +/- half_width
+    double min;
+    double max;
+} MetricStats;
+
+// Welford's update over the K replications of one (policy, metric)
+void replicate_stats(const Replication* rep, int policy, int metric, MetricStats* out) {
+    double mean = 0;
+    double m2 = 0;
+    out->min = 0;
+    out->max = 0;
+    for (int r = 0; r < rep->replications; r++) {
+        double x = replicate_metric(&rep->results[r * rep->npolicies + policy], metric);
+        double delta = x - mean;
+        mean += delta / (r + 1);
+        m2 += delta * (x - mean);
+        if (r == 0 || x < out->min) out->min = x;
+        if (r == 0 || x > out->max) out->max = x;
+    }
+    int k = rep->replications;
+    out->mean = mean;
+    out->stddev = k > 1 ? sqrt(m2 / (k - 1)) : 0.0;
+    out->half_width = k > 1 ? student_t_95(k - 1) * out->stddev / sqrt((double)k) : 0.0;
+}
+
+void print_policy_intervals(const Replication* rep, int policy) {
+    printf("\n================================================================================\n");
+    printf("%s (%d Replications, 95%% Confidence Intervals)\n", rep->policies[policy]->name, rep->replications);
+    printf("================================================================================\n");
+    printf("\n+--------------------------+--------------+--------------+--------------+--------------+--------------+\n");
+    printf("| Metric                   | Mean         | 95%% CI +/-   | Std Dev      | Min          | Max          |\n");
+    printf("+--------------------------+--------------+--------------+--------------+--------------+--------------+\n");
+    for (int m = 0; m < REPLICATE_METRIC_COUNT; m++) {
+        MetricStats st;
+        replicate_stats(rep, policy, m, &st);
+        printf("| %-24s | %-12.3f | %-12.3f | %-12.3f | %-12.3f | %-12.3f |\n",
+               replicate_metric_names[m], st.mean, st.half_width, st.stddev, st.min, st.max);
+    }
+    printf("+--------------------------+--------------+--------------+--------------+--------------+--------------+\n");
+}
+
+// Headline metrics of every policy side by side, as mean +/- half width
+void print_interval_summary(const Replication* rep) {
+    const int columns[4] = {1, 6, 2, 7};
+    printf("\n================================================================================\n");
+    printf("POLICY SUMMARY (mean +/- 95%% CI over %d replications)\n", rep->replications);
+    printf("================================================================================\n");
+    printf("\n+---------------------+----------------------+----------------------+----------------------+----------------------+\n");
+    printf("| Policy              | Avg Response (ms)    | P99 POS Resp (ms)    | Avg Turnaround (ms)  | CPU Utilization (%%)  |\n");
+    printf("+---------------------+----------------------+----------------------+----------------------+----------------------+\n");
+    for (int p = 0; p < rep->npolicies; p++) {
+        printf("| %-19s |", rep->policies[p]->name);
+        for (int c = 0; c < 4; c++) {
+            MetricStats st;
+            replicate_stats(rep, p, columns[c], &st);
+            char cell[32];
+            snprintf(cell, sizeof(cell), "%.3f +/- %.3f", st.mean, st.half_width);
+            printf(" %-20s |", cell);
+        }
+        printf("\n");
+    }
+    printf("+---------------------+----------------------+----------------------+----------------------+----------------------+\n");
+}
+
+// Percentiles over all K x count tasks at once, from the merged histograms:
+// the tail a single replication is too short to show
+void print_pooled_tails(const Replication* rep) {
+    printf("\n================================================================================\n");
+    printf("POOLED RESPONSE TIME TAILS (all %d replications merged, ms)\n", rep->replications);
+    printf("================================================================================\n");
+    printf("\n+---------------------+------------+------------+------------+------------+------------+------------+\n");
+    printf("| Policy              | POS P50    | POS P99    | POS P99.9  | LPUS P50   | LPUS P99   | LPUS P99.9 |\n");
+    printf("+---------------------+------------+------------+------------+------------+------------+------------+\n");
+    for (int p = 0; p < rep->npolicies; p++) {
+        const Histogram* pos = &rep->pooled[p].hist[TASK_CLASS_FOREGROUND][SIM_METRIC_RESPONSE];
+        const Histogram* lpus = &rep->pooled[p].hist[TASK_CLASS_BACKGROUND][SIM_METRIC_RESPONSE];
+        printf("| %-19s | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f |\n",
+               rep->policies[p]->name,
+               sim_ms((sim_time_t)hist_percentile(pos, 50.0)),
+               sim_ms((sim_time_t)hist_percentile(pos, 99.0)),
+               sim_ms((sim_time_t)hist_percentile(pos, 99.9)),
+               sim_ms((sim_time_t)hist_percentile(lpus, 50.0)),
+               sim_ms((sim_time_t)hist_percentile(lpus, 99.0)),
+               sim_ms((sim_time_t)hist_percentile(lpus, 99.9)));
+    }
+    printf("+---------------------+------------+------------+------------+------------+------------+------------+\n");
+}
+
+void print_replicate_usage(void) {
+    fprintf(stderr, "Replication options:\n");
+    fprintf(stderr, "  --replications K       independent workload instances (default 30, >= 2)\n");
+    fprintf(stderr, "  --jobs N               worker threads (default: online CPUs)\n");
+    fprintf(stderr, "  --policies LIST        comma-separated subset of (default: all)\n");
+    fprintf(stderr, "                         %s\n", SIM_POLICY_NAMES);
+    fprintf(stderr, "Workload options (see workload_generator; --count defaults to 20000 here):\n");
+    generator_print_options();
+}
+
+// Consume the replication and generator options and drop them from argv.
+// Returns the remaining argc, -1 on a bad option.
+int parse_replicate_options(int argc, char** argv, Replication* rep, int* jobs) {
+    const char* list = NULL;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--replications") == 0 && value != NULL) {
+            rep->replications = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jobs") == 0 && value != NULL) {
+            *jobs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--policies") == 0 && value != NULL) {
+            list = argv[++i];
+        } else if (value != NULL && generator_apply_option(&rep->config, argv[i], value)) {
+            i++;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    if (rep->replications < 2 || *jobs < 1 || rep->config.count < 1 || rep->config.count > UINT32_MAX) {
+        print_replicate_usage();
+        return -1;
+    }
+    if (generator_check_config(&rep->config) != 0) return -1;
+    rep->npolicies = sim_parse_policy_list(list, rep->policies);
+    if (rep->npolicies < 0) {
+        print_replicate_usage();
+        return -1;
+    }
+    return kept;
+}
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    Replication rep;
+    int jobs = parallel_default_threads();
+    memset(&rep, 0, sizeof(rep));
+    generator_default_config(&rep.config);
+    rep.config.count = 20000;
+    rep.replications = 30;
+
+    argc = parse_replicate_options(argc, argv, &rep, &jobs);
+    if (argc < 0) return 1;
+    if (sim_parse_options(&options, argc, argv) != 0) {
+        print_replicate_usage();
+        return 1;
+    }
+    if (options.workload_path != NULL || options.trace_path != NULL || options.realtime) {
+        fprintf(stderr, "replicate: workloads are generated; --workload, --trace and --realtime do not apply\n");
+        return 1;
+    }
+    rep.options = &options;
+    rep.results = (SimSummary*)calloc((size_t)rep.replications * rep.npolicies, sizeof(SimSummary));
+    rep.pooled = (SimLatency*)malloc(sizeof(SimLatency) * rep.npolicies);
+    if (rep.results == NULL || rep.pooled == NULL) {
+        perror("replicate: calloc failed");
+        return 1;
+    }
+    for (int p = 0; p < rep.npolicies; p++) {
+        sim_latency_init(&rep.pooled[p]);
+    }
+    pthread_mutex_init(&rep.lock, NULL);
+
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX LPUS BACKEND MONTE CARLO REPLICATION\n");
+    printf("Ubuntu 22.04 LTS Server | %d Policies x %d Replications on %d Worker Thread%s\n",
+           rep.npolicies, rep.replications, jobs, jobs == 1 ? "" : "s");
+    printf("Workload: %llu tasks/replication, %s arrivals at %g/s, %s bursts, seed %llu (%d CPU%s)\n",
+           (unsigned long long)rep.config.count,
+           arrival_process_names[rep.config.arrival_process], rep.config.rate,
+           burst_distribution_names[rep.config.burst_distribution],
+           (unsigned long long)rep.config.seed,
+           options.cpus, options.cpus == 1 ? "" : "s");
+    printf("================================================================================\n");
+
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    parallel_run(replicate_job, &rep, rep.replications, jobs);
+    double wall = parallel_elapsed(&started);
+
+    for (int p = 0; p < rep.npolicies; p++) {
+        print_policy_intervals(&rep, p);
+    }
+    print_interval_summary(&rep);
+    print_pooled_tails(&rep);
+
+    double serial = 0;
+    for (int i = 0; i < rep.replications * rep.npolicies; i++) {
+        serial += rep.results[i].wall_seconds;
+    }
+    printf("\nWall Time:               %.2f s (%.2f s of simulation, %.2fx parallel speedup)\n",
+           wall, serial, wall > 0 ? serial / wall : 0.0);
+
+    pthread_mutex_destroy(&rep.lock);
+    free(rep.pooled);
+    free(rep.results);
+    return 0;
+}
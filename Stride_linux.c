@@ -0,0 +1,227 @@
+// primecart_linux_stride.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "primecart_cli.h"
+
+int lottery_mode = 0; // --lottery: draw the class instead of stepping passes
+
+void stride_on_dispatch(SchedSim* sim, int task, int first_run) {
+    if (first_run) {
+        LinuxProcess* p = &sim->procs[task];
+        printf("[Time %.3fms] %s started (Response Time: %.3fms)\n", 
+               sim_ms(sim->current_time), p->pid, sim_ms(p->response_time));
+    }
+}
+
+void stride_on_preempt(SchedSim* sim, int task, int next, int reason) {
+    (void)next;
+    (void)reason;
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s preempted (pass %g, %gms remaining)\n",
+           sim_ms(sim->current_time), p->pid, sim_ms(p->pass), sim_ms(p->remaining_time));
+}
+
+void stride_on_complete(SchedSim* sim, int task) {
+    LinuxProcess* p = &sim->procs[task];
+    printf("[Time %.3fms] %s completed\n", sim_ms(sim->current_time), p->pid);
+    printf("      Turnaround: %.3fms, Waiting: %.3fms\n\n",
+           sim_ms(p->turnaround_time),
+           sim_ms(p->waiting_time));
+}
+
+// Configured vs achieved CPU share per class, over the whole run and over
+// the sliding windows in which both classes were competing (all CPUs)
+void print_share_report(const SchedSim* sim) {
+    sim_time_t total[TASK_CLASS_COUNT] = {0};
+    sim_time_t busy = 0;
+    long long windows = 0;
+    double share_sum[TASK_CLASS_COUNT] = {0};
+    double share_min[TASK_CLASS_COUNT] = {0};
+    double share_max[TASK_CLASS_COUNT] = {0};
+    long long on_target[TASK_CLASS_COUNT] = {0};
+    for (int cpu = 0; cpu < sim->ncpus; cpu++) {
+        const StrideShare* s = &((const StrideRunqueue*)sim->cpus[cpu].rq)->share;
+        for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+            total[c] += s->total[c];
+            busy += s->total[c];
+            if (s->windows == 0) continue;
+            if (windows == 0 || s->share_min[c] < share_min[c]) share_min[c] = s->share_min[c];
+            if (windows == 0 || s->share_max[c] > share_max[c]) share_max[c] = s->share_max[c];
+            share_sum[c] += s->share_sum[c];
+            on_target[c] += s->on_target[c];
+        }
+        windows += s->windows;
+    }
+
+    printf("\n================================================================================\n");
+    printf("CPU SHARE: CONFIGURED vs ACHIEVED (%gms Sliding Windows)\n", sim_ms(stride_config.window));
+    printf("================================================================================\n");
+    printf("\n+--------------+---------+------------+------------+------------+------------+------------+------------+\n");
+    printf("| Class        | Tickets | Configured | Overall    | Win Mean   | Win Min    | Win Max    | On Target  |\n");
+    printf("+--------------+---------+------------+------------+------------+------------+------------+------------+\n");
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        double n = windows ? (double)windows : 1.0;
+        printf("| %-12s | %-7d | %9.2f%% | %9.2f%% | %9.2f%% | %9.2f%% | %9.2f%% | %9.2f%% |\n",
+               task_class_names[c],
+               stride_config.tickets[c],
+               stride_configured_share(c) * 100.0,
+               busy ? total[c] * 100.0 / busy : 0.0,
+               share_sum[c] * 100.0 / n,
+               share_min[c] * 100.0,
+               share_max[c] * 100.0,
+               on_target[c] * 100.0 / n);
+    }
+    printf("+--------------+---------+------------+------------+------------+------------+------------+------------+\n");
+    printf("Contended windows: %lld (both classes ready at every decision; slide %gms)\n",
+           windows, sim_ms(stride_bucket_width()));
+    printf("On Target: window share within %.0f points of the configured share\n",
+           STRIDE_SHARE_TOLERANCE * 100.0);
+}
+
+void run_linux_stride_analysis(const SimOptions* options, const Workload* workload) {
+    const SchedPolicy* policy = lottery_mode ? &LOTTERY_POLICY : &STRIDE_POLICY;
+    const char* name = lottery_mode ? "LOTTERY" : "STRIDE";
+    printf("================================================================================\n");
+    printf("PRIMECART RETAIL - LINUX LPUS BACKEND %s SCHEDULING ANALYSIS\n", name);
+    printf("Ubuntu 22.04 LTS Server | %s Proportional Share (POS %d : LPUS %d tickets, Quantum: %dms)\n",
+           policy->name,
+           stride_config.tickets[TASK_CLASS_FOREGROUND],
+           stride_config.tickets[TASK_CLASS_BACKGROUND],
+           TIME_QUANTUM);
+    printf("Workload: %s (%zu processes)\n", workload->name, workload->count);
+    printf("================================================================================\n");
+    
+    SchedSim sim;
+    sim_init(&sim, policy, workload);
+    sim_apply_options(&sim, options);
+    
+    if (options->quiet) {
+        sim_run(&sim, NULL);
+    } else {
+        // Print Process Table
+        sim_print_process_table(workload, "PROCESS TABLE (Sorted by Arrival Time):");
+        
+        printf("\nEXECUTION TIMELINE (All times in milliseconds):\n");
+        printf("================================================================================\n\n");
+        
+        // Main scheduling loop
+        SchedHooks hooks = { stride_on_dispatch, stride_on_preempt, stride_on_complete };
+        sim_run(&sim, &hooks);
+        
+        // Print Gantt Chart
+        const char* title = sim.policy == &LOTTERY_POLICY ? "LOTTERY SCHEDULING (Proportional Share)"
+                                                          : "STRIDE SCHEDULING (Proportional Share)";
+        sim_print_gantt(&sim, title, 1);
+    }
+    
+    sim_print_system_metrics(&sim, lottery_mode ? " (Lottery Scheduling)" : " (Stride Scheduling)");
+    sim_print_class_metrics(&sim, " (POS vs LPUS under Proportional Share)");
+    sim_print_tail_latency(&sim, " (POS vs LPUS under Proportional Share)");
+    print_share_report(&sim);
+    
+    if (!options->quiet) {
+        sim_print_process_metrics(&sim, lottery_mode ? " (Lottery Execution)" : " (Stride Execution)", NULL, sim.count);
+    }
+    
+    // PrimeCart Threshold Analysis
+    const char* const why[5] = {
+        "Tickets set CPU share, not reaction time: POS wake-up relies on the kernel",
+        "Shares hold over many quanta; jitter skews the short windows POS sees",
+        "Every 5ms quantum can switch between the POS and LPUS classes",
+        "Proportional shares protect POS only while there is capacity to share",
+        "LPUS results must reach POS terminals within the POS share of the CPU"
+    };
+    sim_print_threshold_analysis(&sim, lottery_mode ? " - Lottery" : " - Stride", why);
+    
+    // Proportional Share Algorithm Analysis
+    printf("\n================================================================================\n");
+    printf("%s ALGORITHM ANALYSIS\n", name);
+    printf("================================================================================\n");
+    
+    printf("\n%s Selection Logic:\n", policy->name);
+    if (lottery_mode) {
+        printf("• Each quantum a ticket is drawn among the classes with ready tasks\n");
+        printf("• A class wins in proportion to its tickets, on average\n");
+    } else {
+        printf("• Each class has a pass value; the ready class with the lowest pass runs\n");
+        printf("• Running advances the class pass by CPU time x %d / tickets\n", STRIDE1);
+    }
+    printf("• Within a class the least-served task (lowest own pass) runs: O(log n) heap\n");
+    printf("• A class that was idle rejoins at the current pass, with no banked credit\n");
+    
+    printf("\nImpact on LPUS Backend Operations:\n");
+    printf("✓ LPUS inventory sync keeps a guaranteed %.0f%% CPU share under POS load\n",
+           stride_configured_share(TASK_CLASS_BACKGROUND) * 100.0);
+    printf("✓ POS keeps the rest; unused share flows to whichever class has work\n");
+    printf("✗ A POS arrival waits for the current quantum instead of preempting\n");
+    if (lottery_mode) {
+        printf("✗ Shares only hold on average; short windows can drift\n");
+    }
+    
+    printf("\n================================================================================\n");
+    printf("ANALYSIS COMPLETE\n");
+    printf("================================================================================\n");
+    
+    sim_free(&sim);
+}
+
+void print_stride_usage(void) {
+    fprintf(stderr, "Stride options:\n");
+    fprintf(stderr, "  --tickets POS,LPUS  class tickets, each >= 1 (default 80,20)\n");
+    fprintf(stderr, "  --lottery           draw the class by lottery instead of stride passes\n");
+    fprintf(stderr, "  --seed N            lottery random seed (default 1)\n");
+    fprintf(stderr, "  --window MS         sliding window of the share report (default 1000)\n");
+}
+
+// Consume the stride options into stride_config and drop them from argv.
+// Returns the remaining argc, -1 on a bad option.
+int parse_stride_options(int argc, char** argv) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tickets") == 0 && i + 1 < argc) {
+            int pos;
+            int lpus;
+            if (sscanf(argv[++i], "%d,%d", &pos, &lpus) != 2 || pos < 1 || lpus < 1) {
+                print_stride_usage();
+                return -1;
+            }
+            stride_config.tickets[TASK_CLASS_FOREGROUND] = pos;
+            stride_config.tickets[TASK_CLASS_BACKGROUND] = lpus;
+        } else if (strcmp(argv[i], "--lottery") == 0) {
+            lottery_mode = 1;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            stride_config.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            double ms = atof(argv[++i]);
+            if (ms <= 0) {
+                print_stride_usage();
+                return -1;
+            }
+            stride_config.window = MS_TO_NS(ms);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    return kept;
+}
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    Workload workload;
+    argc = parse_stride_options(argc, argv);
+    if (argc < 0) return 1;
+    if (sim_parse_options(&options, argc, argv) != 0) {
+        print_stride_usage();
+        return 1;
+    }
+    if (sim_open_workload(&options, &workload) != 0) return 1;
+    
+    run_linux_stride_analysis(&options, &workload);
+    
+    workload_free(&workload);
+    return 0;
+}
@@ -0,0 +1,135 @@
+// primecart_cli.h
+// Command-line options shared by the PrimeCart Linux simulators.
+#ifndef PRIMECART_CLI_H
+#define PRIMECART_CLI_H
+
+#include "primecart_policies.h"
+#include "primecart_export.h"
+
+typedef struct {
+    const char* workload_path; // NULL = built-in reference workload
+    int quiet;                 // summary metrics only, no per-task output
+    int realtime;              // replay against the wall clock (default: virtual time)
+    long gantt_memory_mb;      // Gantt slices kept in RAM before spilling, 0 = no limit
+    const char* trace_path;    // schedule export (JSON or binary), NULL = none
+    int cpus;                  // simulated CPUs (default 1)
+    int balance;               // SIM_BALANCE_*
+    double balance_period_ms;  // SIM_BALANCE_PERIODIC interval
+    const char* host_profile;  // measured host figures (probe), NULL = reference
+    int stream;                // drop finished tasks: constant memory, implies quiet
+} SimOptions;
+
+void sim_print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--workload FILE] [--quiet] [--realtime] [--gantt-memory MB] [--trace FILE]\n"
+                    "       [--cpus N] [--balance steal|periodic|none] [--balance-period MS]\n"
+                    "       [--host-profile FILE] [--stream]\n", program);
+    fprintf(stderr, "  --workload FILE  replay a CSV or binary PrimeCart trace instead of P1-P7\n");
+    fprintf(stderr, "  --quiet          print summary metrics only (for large traces)\n");
+    fprintf(stderr, "  --realtime       replay events at wall-clock pace instead of virtual time\n");
+    fprintf(stderr, "  --gantt-memory MB  spill Gantt slices beyond MB of RAM to a temporary file\n");
+    fprintf(stderr, "  --trace FILE     export the schedule: Chrome/Perfetto JSON for *.json, binary otherwise\n");
+    fprintf(stderr, "  --cpus N         simulate N CPUs with per-CPU ready queues (default 1, at most %d)\n",
+            TRACE_MAX_CPUS);
+    fprintf(stderr, "  --balance MODE   steal: idle CPUs pull work (default); periodic: even out\n");
+    fprintf(stderr, "                   queues every --balance-period MS (default 4); none\n");
+    fprintf(stderr, "  --host-profile FILE  use the switch cost and thresholds measured by probe\n");
+    fprintf(stderr, "  --stream         read the trace record by record and forget each task once it\n");
+    fprintf(stderr, "                   finishes, keeping memory constant however long the trace\n");
+    fprintf(stderr, "                   (implies --quiet)\n");
+}
+
+int sim_parse_options(SimOptions* options, int argc, char** argv) {
+    memset(options, 0, sizeof(*options));
+    options->cpus = 1;
+    options->balance = SIM_BALANCE_STEAL;
+    options->balance_period_ms = 4.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--workload") == 0 && i + 1 < argc) {
+            options->workload_path = argv[++i];
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            options->quiet = 1;
+        } else if (strcmp(argv[i], "--realtime") == 0) {
+            options->realtime = 1;
+        } else if (strcmp(argv[i], "--gantt-memory") == 0 && i + 1 < argc) {
+            options->gantt_memory_mb = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            options->trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--cpus") == 0 && i + 1 < argc &&
+                   atoi(argv[i + 1]) > 0 && atoi(argv[i + 1]) <= TRACE_MAX_CPUS) {
+            options->cpus = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--balance") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            options->balance = -1;
+            for (int b = 0; b < 3; b++) {
+                if (strcmp(mode, sim_balance_names[b]) == 0) options->balance = b;
+            }
+            if (options->balance < 0) {
+                sim_print_usage(argv[0]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--balance-period") == 0 && i + 1 < argc && atof(argv[i + 1]) > 0) {
+            options->balance_period_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--host-profile") == 0 && i + 1 < argc) {
+            options->host_profile = argv[++i];
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            options->stream = 1;
+            options->quiet = 1;
+        } else {
+            sim_print_usage(argv[0]);
+            return -1;
+        }
+    }
+    // Loaded here, before any simulation reads sim_host
+    if (options->host_profile != NULL && host_profile_load(&sim_host, options->host_profile) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// Apply run-mode options to a freshly initialized simulation
+void sim_apply_options(SchedSim* sim, const SimOptions* options) {
+    if (options->cpus > 1) {
+        sim_set_cpus(sim, options->cpus);
+    }
+    sim->balance = options->balance;
+    sim->balance_period = MS_TO_NS(options->balance_period_ms);
+    if (options->realtime) {
+        sim_enable_realtime(sim);
+    }
+    if (options->stream) {
+        sim_enable_streaming(sim);
+    }
+    if (sim->workload->streamed) {
+        WorkloadStream* stream = (WorkloadStream*)malloc(sizeof(WorkloadStream));
+        if (stream == NULL) {
+            perror("sim_apply_options: malloc failed");
+            exit(1);
+        }
+        if (workload_stream_open(stream, sim->workload->name) != 0) {
+            exit(1);
+        }
+        sim_set_source(sim, workload_stream_next, stream, sim->workload->name);
+        sim->source.close = workload_stream_free;
+    }
+    // On failure the slices simply stay in memory
+    if (options->gantt_memory_mb > 0) {
+        gantt_enable_spill(&sim->gantt, options->gantt_memory_mb << 20);
+    }
+    if (options->trace_path != NULL && trace_exporter_attach(sim, options->trace_path) != 0) {
+        exit(1);
+    }
+}
+
+int sim_open_workload(const SimOptions* options, Workload* workload) {
+    if (options->workload_path == NULL) {
+        workload_reference(workload);
+        return 0;
+    }
+    if (options->stream) {
+        return workload_open_streamed(workload, options->workload_path);
+    }
+    return workload_load(workload, options->workload_path);
+}
+
+#endif // PRIMECART_CLI_H
@@ -0,0 +1,316 @@
+// primecart_export.h
+// Streaming export of simulated schedules for trace viewers.
+//
+// Events are written as the engine produces them (SimTracer), through one
+// large output buffer, so exporting a multi-million-slice schedule costs a
+// few write() calls per megabyte and no per-event memory.
+//
+//   JSON    Chrome trace-event format; opens in ui.perfetto.dev or
+//           chrome://tracing. One track per CPU with a complete ("X")
+//           event per slice, context switch and idle period, and an
+//           instant ("i") event per preemption. Timestamps are µs with
+//           ns precision.
+//
+//   Binary  TraceFileHeader then one 24-byte TraceRecord per event, in
+//           per-CPU time order (CPUs interleave), until EOF. About 5x
+//           smaller than the JSON and trivial to load with numpy or a few
+//           lines of C.
+#ifndef PRIMECART_EXPORT_H
+#define PRIMECART_EXPORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "primecart_sched.h"
+
+// ---------------------------------------------------------------------------
+// Buffered writer
+// ---------------------------------------------------------------------------
+
+#define TRACE_WRITER_BUFFER (1 << 20)
+#define TRACE_WRITER_MAX_EVENT 512 // room reserved for one formatted event
+
+typedef struct {
+    int fd;
+    char* buf;
+    size_t used;
+    int failed;
+} TraceWriter;
+
+int trace_writer_open(TraceWriter* w, const char* path) {
+    w->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (w->fd < 0) {
+        perror(path);
+        return -1;
+    }
+    w->buf = (char*)malloc(TRACE_WRITER_BUFFER);
+    if (w->buf == NULL) {
+        perror("trace: malloc failed");
+        close(w->fd);
+        return -1;
+    }
+    w->used = 0;
+    w->failed = 0;
+    return 0;
+}
+
+void trace_writer_flush(TraceWriter* w) {
+    size_t done = 0;
+    while (done < w->used && !w->failed) {
+        ssize_t n = write(w->fd, w->buf + done, w->used - done);
+        if (n < 0) {
+            perror("trace: write failed");
+            w->failed = 1;
+        } else {
+            done += (size_t)n;
+        }
+    }
+    w->used = 0;
+}
+
+// Space for at least n more bytes at w->buf + w->used
+char* trace_writer_reserve(TraceWriter* w, size_t n) {
+    if (w->used + n > TRACE_WRITER_BUFFER) {
+        trace_writer_flush(w);
+    }
+    return w->buf + w->used;
+}
+
+void trace_writer_write(TraceWriter* w, const void* data, size_t n) {
+    memcpy(trace_writer_reserve(w, n), data, n);
+    w->used += n;
+}
+
+// Append printf-formatted text (at most TRACE_WRITER_MAX_EVENT bytes)
+void trace_writer_printf(TraceWriter* w, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void trace_writer_printf(TraceWriter* w, const char* format, ...) {
+    char* p = trace_writer_reserve(w, TRACE_WRITER_MAX_EVENT);
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(p, TRACE_WRITER_MAX_EVENT, format, args);
+    va_end(args);
+    if (n > 0) {
+        w->used += n < TRACE_WRITER_MAX_EVENT ? (size_t)n : TRACE_WRITER_MAX_EVENT - 1;
+    }
+}
+
+int trace_writer_close(TraceWriter* w) {
+    trace_writer_flush(w);
+    free(w->buf);
+    if (close(w->fd) != 0 && !w->failed) {
+        perror("trace: close failed");
+        w->failed = 1;
+    }
+    return w->failed ? -1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Binary format
+// ---------------------------------------------------------------------------
+
+#define TRACE_MAGIC "PCTR"
+#define TRACE_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t reserved;
+} TraceFileHeader;
+
+typedef struct {
+    uint8_t type;       // SIM_TRACE_*
+    uint8_t reason;     // SCHED_PREEMPT_* for preemptions
+    uint16_t cpu;
+    uint32_t pid;       // workload pid, 0 for idle
+    int64_t start_ns;
+    int64_t end_ns;
+} TraceRecord;          // 24 bytes
+
+// ---------------------------------------------------------------------------
+// Exporter
+// ---------------------------------------------------------------------------
+
+#define TRACE_FORMAT_JSON   0
+#define TRACE_FORMAT_BINARY 1
+
+#define TRACE_MAX_CPUS 1024 // also the --cpus limit; TraceRecord.cpu is 16-bit
+
+typedef struct {
+    TraceWriter writer;
+    int format;
+    const char* path;
+    int first_event;          // JSON: no comma before the first event
+    char cpu_named[TRACE_MAX_CPUS]; // JSON: thread_name metadata emitted
+    // The engine reports one slice per run step; consecutive steps of the
+    // same task are merged here so each uninterrupted run is one event
+    int has_pending;
+    SimTraceEvent pending;
+    LinuxProcess pending_task; // copied: a streaming run may reuse the slot first
+} TraceExporter;
+
+// Timestamp in µs with ns precision, as Chrome's trace format expects
+#define TRACE_US_FMT "%lld.%03lld"
+#define TRACE_US(ns) (long long)((ns) / 1000), (long long)((ns) % 1000)
+
+const char* trace_preempt_reason(int reason) {
+    return reason == SCHED_PREEMPT_QUANTUM ? "quantum" : "priority";
+}
+
+void trace_json_event(TraceExporter* ex, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void trace_json_event(TraceExporter* ex, const char* format, ...) {
+    TraceWriter* w = &ex->writer;
+    char* p = trace_writer_reserve(w, TRACE_WRITER_MAX_EVENT);
+    int prefix = ex->first_event ? 0 : 2;
+    if (prefix) memcpy(p, ",\n", 2);
+    ex->first_event = 0;
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(p + prefix, TRACE_WRITER_MAX_EVENT - prefix, format, args);
+    va_end(args);
+    if (n > 0) {
+        int room = TRACE_WRITER_MAX_EVENT - prefix;
+        w->used += (size_t)(prefix + (n < room ? n : room - 1));
+    }
+}
+
+void trace_write_json(TraceExporter* ex, const SimTraceEvent* e, const LinuxProcess* p) {
+    if (e->cpu >= 0 && e->cpu < TRACE_MAX_CPUS && !ex->cpu_named[e->cpu]) {
+        ex->cpu_named[e->cpu] = 1;
+        trace_json_event(ex, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"CPU %d\"}}",
+                         e->cpu, e->cpu);
+    }
+
+    switch (e->type) {
+        case SIM_TRACE_SLICE:
+            trace_json_event(ex, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                 "\"ts\":" TRACE_US_FMT ",\"dur\":" TRACE_US_FMT ","
+                                 "\"args\":{\"kind\":\"%s\",\"priority\":%d}}",
+                             p->pid, p->process_type, e->cpu,
+                             TRACE_US(e->start), TRACE_US(e->end - e->start),
+                             task_kinds[p->kind].name, p->priority);
+            break;
+        case SIM_TRACE_SWITCH:
+            trace_json_event(ex, "{\"name\":\"context switch\",\"cat\":\"sched\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                 "\"ts\":" TRACE_US_FMT ",\"dur\":" TRACE_US_FMT ",\"args\":{\"next\":\"%s\"}}",
+                             e->cpu, TRACE_US(e->start), TRACE_US(e->end - e->start), p->pid);
+            break;
+        case SIM_TRACE_IDLE:
+            trace_json_event(ex, "{\"name\":\"idle\",\"cat\":\"sched\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                 "\"ts\":" TRACE_US_FMT ",\"dur\":" TRACE_US_FMT "}",
+                             e->cpu, TRACE_US(e->start), TRACE_US(e->end - e->start));
+            break;
+        case SIM_TRACE_PREEMPT:
+            trace_json_event(ex, "{\"name\":\"preempt %s\",\"cat\":\"sched\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,"
+                                 "\"ts\":" TRACE_US_FMT ",\"args\":{\"reason\":\"%s\"}}",
+                             p->pid, e->cpu, TRACE_US(e->start), trace_preempt_reason(e->reason));
+            break;
+    }
+}
+
+void trace_write_binary(TraceExporter* ex, const SimTraceEvent* e, const LinuxProcess* p) {
+    TraceRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.type = (uint8_t)e->type;
+    rec.reason = (uint8_t)e->reason;
+    rec.cpu = (uint16_t)e->cpu;
+    rec.pid = p != NULL ? p->id : 0;
+    rec.start_ns = e->start;
+    rec.end_ns = e->end;
+    trace_writer_write(&ex->writer, &rec, sizeof(rec));
+}
+
+// p is the event's task, NULL for idle
+void trace_write_event(TraceExporter* ex, const SimTraceEvent* e, const LinuxProcess* p) {
+    if (ex->format == TRACE_FORMAT_JSON) {
+        trace_write_json(ex, e, p);
+    } else {
+        trace_write_binary(ex, e, p);
+    }
+}
+
+void trace_flush_pending(TraceExporter* ex) {
+    if (ex->has_pending) {
+        trace_write_event(ex, &ex->pending, &ex->pending_task);
+        ex->has_pending = 0;
+    }
+}
+
+void trace_exporter_emit(void* ctx, const SchedSim* sim, const SimTraceEvent* e) {
+    TraceExporter* ex = (TraceExporter*)ctx;
+    const LinuxProcess* p = e->task >= 0 ? &sim->procs[e->task] : NULL;
+
+    if (e->type == SIM_TRACE_SLICE) {
+        if (ex->has_pending && ex->pending.task == e->task && ex->pending.cpu == e->cpu &&
+            ex->pending.end == e->start && ex->pending_task.seq == p->seq) {
+            ex->pending.end = e->end;
+            return;
+        }
+        trace_flush_pending(ex);
+        ex->pending = *e;
+        ex->pending_task = *p;
+        ex->has_pending = 1;
+        return;
+    }
+    // Keep the stream in time order: an open slice ends before anything else starts
+    trace_flush_pending(ex);
+    trace_write_event(ex, e, p);
+}
+
+void trace_exporter_close(void* ctx) {
+    TraceExporter* ex = (TraceExporter*)ctx;
+    trace_flush_pending(ex);
+    if (ex->format == TRACE_FORMAT_JSON) {
+        trace_writer_printf(&ex->writer, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    }
+    if (trace_writer_close(&ex->writer) == 0) {
+        fprintf(stderr, "Schedule trace written to %s\n", ex->path);
+    }
+    free(ex);
+}
+
+// Stream sim's schedule to path: JSON for *.json, binary otherwise.
+// The file is finalized by sim_free().
+int trace_exporter_attach(SchedSim* sim, const char* path) {
+    TraceExporter* ex = (TraceExporter*)calloc(1, sizeof(TraceExporter));
+    if (ex == NULL) {
+        perror("trace: malloc failed");
+        return -1;
+    }
+    if (trace_writer_open(&ex->writer, path) != 0) {
+        free(ex);
+        return -1;
+    }
+    size_t len = strlen(path);
+    ex->format = len > 5 && strcmp(path + len - 5, ".json") == 0 ? TRACE_FORMAT_JSON : TRACE_FORMAT_BINARY;
+    ex->path = path;
+    ex->first_event = 1;
+
+    if (ex->format == TRACE_FORMAT_JSON) {
+        trace_writer_printf(&ex->writer, "{\"traceEvents\":[\n");
+        trace_json_event(ex, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"PrimeCart %s\"}}",
+                         sim->policy->name);
+    } else {
+        TraceFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, TRACE_MAGIC, 4);
+        header.version = TRACE_VERSION;
+        header.record_size = sizeof(TraceRecord);
+        trace_writer_write(&ex->writer, &header, sizeof(header));
+    }
+
+    sim->tracer.ctx = ex;
+    sim->tracer.emit = trace_exporter_emit;
+    sim->tracer.close = trace_exporter_close;
+    return 0;
+}
+
+#endif // PRIMECART_EXPORT_H
@@ -0,0 +1,140 @@
+// primecart_gantt.h
+// Execution-slice log behind the Gantt charts and schedule exports.
+//
+// Slices are appended into fixed-size chunks. A chunk never moves once
+// allocated: growing the log adds a chunk instead of realloc-copying
+// everything, and the only per-chunk bookkeeping is one pointer in the
+// chunk table. With spilling enabled, at most resident_limit chunks stay in
+// memory; older full chunks are written to an unlinked temporary file and
+// their memory is reused for new slices, so RSS stays bounded no matter how
+// many slices a run produces. Spilled slices are read back with pread().
+#ifndef PRIMECART_GANTT_H
+#define PRIMECART_GANTT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// One contiguous stretch of CPU time given to a process
+typedef struct {
+    int process_index;
+    int cpu;
+    long long start_time;   // ns
+    long long end_time;     // ns
+} GanttEvent;
+
+#define GANTT_CHUNK_EVENTS 4096
+#define GANTT_CHUNK_BYTES  (sizeof(GanttEvent) * GANTT_CHUNK_EVENTS)
+
+typedef struct {
+    GanttEvent** chunks;        // chunk table; NULL once a chunk was spilled
+    long long chunk_count;
+    long long chunk_table_capacity;
+    long long count;            // slices recorded
+
+    int spill_fd;               // -1 = everything stays in memory
+    long long resident_limit;   // chunks kept in memory when spilling
+    long long first_resident;   // chunks below this index are on disk
+} GanttBuffer;
+
+void gantt_init(GanttBuffer* buf) {
+    memset(buf, 0, sizeof(*buf));
+    buf->spill_fd = -1;
+}
+
+// Keep at most max_bytes of slices in memory, spilling the rest to a
+// temporary file. Returns 0 on success.
+int gantt_enable_spill(GanttBuffer* buf, long long max_bytes) {
+    char path[] = "/tmp/primecart_gantt_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("gantt: cannot create spill file");
+        return -1;
+    }
+    unlink(path); // removed automatically when the fd is closed
+    buf->spill_fd = fd;
+    buf->resident_limit = max_bytes / (long long)GANTT_CHUNK_BYTES;
+    if (buf->resident_limit < 2) buf->resident_limit = 2;
+    return 0;
+}
+
+void gantt_free(GanttBuffer* buf) {
+    for (long long i = buf->first_resident; i < buf->chunk_count; i++) {
+        free(buf->chunks[i]);
+    }
+    free(buf->chunks);
+    if (buf->spill_fd >= 0) {
+        close(buf->spill_fd);
+    }
+    gantt_init(buf);
+}
+
+// Memory for the next chunk: a fresh allocation, or the oldest resident
+// chunk once the resident limit is reached (after writing it out)
+GanttEvent* gantt_new_chunk(GanttBuffer* buf) {
+    if (buf->spill_fd >= 0 && buf->chunk_count - buf->first_resident >= buf->resident_limit) {
+        long long oldest = buf->first_resident;
+        GanttEvent* chunk = buf->chunks[oldest];
+        if (pwrite(buf->spill_fd, chunk, GANTT_CHUNK_BYTES, (off_t)(oldest * GANTT_CHUNK_BYTES)) != (ssize_t)GANTT_CHUNK_BYTES) {
+            perror("gantt: spill write failed");
+            exit(1);
+        }
+        buf->chunks[oldest] = NULL;
+        buf->first_resident++;
+        return chunk;
+    }
+    GanttEvent* chunk = (GanttEvent*)malloc(GANTT_CHUNK_BYTES);
+    if (chunk == NULL) {
+        perror("gantt: malloc failed");
+        exit(1);
+    }
+    return chunk;
+}
+
+// Last recorded slice, NULL if empty (always resident)
+GanttEvent* gantt_last(GanttBuffer* buf) {
+    if (buf->count == 0) return NULL;
+    long long i = buf->count - 1;
+    return &buf->chunks[i / GANTT_CHUNK_EVENTS][i % GANTT_CHUNK_EVENTS];
+}
+
+void gantt_append(GanttBuffer* buf, int cpu, int task, long long start, long long end) {
+    long long slot = buf->count % GANTT_CHUNK_EVENTS;
+    if (slot == 0) {
+        if (buf->chunk_count == buf->chunk_table_capacity) {
+            long long capacity = buf->chunk_table_capacity ? buf->chunk_table_capacity * 2 : 64;
+            GanttEvent** grown = (GanttEvent**)realloc(buf->chunks, sizeof(GanttEvent*) * capacity);
+            if (grown == NULL) {
+                perror("gantt: realloc failed");
+                exit(1);
+            }
+            buf->chunks = grown;
+            buf->chunk_table_capacity = capacity;
+        }
+        buf->chunks[buf->chunk_count] = gantt_new_chunk(buf);
+        buf->chunk_count++;
+    }
+    GanttEvent* e = &buf->chunks[buf->chunk_count - 1][slot];
+    e->process_index = task;
+    e->cpu = cpu;
+    e->start_time = start;
+    e->end_time = end;
+    buf->count++;
+}
+
+// Slice i by value, read back from the spill file if necessary
+GanttEvent gantt_get(const GanttBuffer* buf, long long i) {
+    const GanttEvent* chunk = buf->chunks[i / GANTT_CHUNK_EVENTS];
+    if (chunk != NULL) {
+        return chunk[i % GANTT_CHUNK_EVENTS];
+    }
+    GanttEvent e;
+    if (pread(buf->spill_fd, &e, sizeof(e), (off_t)(i * sizeof(GanttEvent))) != (ssize_t)sizeof(e)) {
+        perror("gantt: spill read failed");
+        exit(1);
+    }
+    return e;
+}
+
+#endif // PRIMECART_GANTT_H
@@ -0,0 +1,272 @@
+// primecart_generator.h
+// Synthetic PrimeCart retail workloads for capacity planning.
+//
+// Tasks are drawn one at a time (no buffering), so traces of any length
+// stream straight to disk:
+//
+//   Arrivals  Poisson at a fixed rate, or a two-state MMPP (Markov-modulated
+//             Poisson process) that alternates between a normal rate and a
+//             peak rate, with exponentially distributed time in each state.
+//             The peak state models Black-Friday-style checkout rushes.
+//
+//   Classes   Each arrival is a Foreground POS task with probability
+//             foreground_share, otherwise a Background LPUS job; the kind
+//             within the class is picked from generator_classes[].
+//
+//   Bursts    Exponential, lognormal or Pareto, all scaled so the mean
+//             equals the kind's mean burst (from the P1-P7 reference set).
+//
+// The same GeneratorConfig (including seed) always produces the same trace.
+#ifndef PRIMECART_GENERATOR_H
+#define PRIMECART_GENERATOR_H
+
+#include <math.h>
+
+#include "primecart_workload.h"
+#include "primecart_rng.h"
+
+#define ARRIVAL_POISSON 0
+#define ARRIVAL_MMPP    1
+
+#define BURST_EXPONENTIAL 0
+#define BURST_LOGNORMAL   1
+#define BURST_PARETO      2
+
+#define GENERATOR_MIN_BURST_NS 1000LL                  // 1 μs, so no task is empty
+#define GENERATOR_MAX_BURST_NS (3600LL * 1000000000LL) // 1 h cap on Pareto outliers
+
+typedef struct {
+    uint64_t count;             // tasks to generate
+    uint64_t seed;
+    int arrival_process;        // ARRIVAL_*
+    double rate;                // tasks/second (Poisson, MMPP normal state)
+    double peak_rate;           // tasks/second in the MMPP peak state
+    double normal_dwell_ms;     // mean time in the MMPP normal state
+    double peak_dwell_ms;       // mean time in the MMPP peak state
+    int burst_distribution;     // BURST_*
+    double lognormal_sigma;     // shape of the lognormal bursts
+    double pareto_alpha;        // tail index of the Pareto bursts (> 1)
+    double foreground_share;    // fraction of arrivals that are POS tasks
+    double burst_scale;         // multiplier on every class mean burst
+} GeneratorConfig;
+
+// Task kind mix within each class
+typedef struct {
+    int kind;
+    double weight;              // share within its class
+    double mean_burst_ms;
+    int priority;
+} GeneratorClass;
+
+#define GENERATOR_CLASS_COUNT 7
+
+const GeneratorClass generator_classes[GENERATOR_CLASS_COUNT] = {
+    {TASK_KIND_POS_SCAN,       0.40,  6.0, 1},
+    {TASK_KIND_POS_LOOKUP,     0.30,  4.0, 1},
+    {TASK_KIND_POS_PAYMENT,    0.15,  8.0, 2},
+    {TASK_KIND_POS_RECEIPT,    0.15,  4.0, 1},
+    {TASK_KIND_LPUS_BATCH,     0.30, 20.0, 4},
+    {TASK_KIND_LPUS_INVENTORY, 0.30, 12.0, 4},
+    {TASK_KIND_LPUS_METADATA,  0.40, 10.0, 5}
+};
+
+const char* arrival_process_names[] = {"poisson", "mmpp"};
+const char* burst_distribution_names[] = {"exponential", "lognormal", "pareto"};
+
+// Defaults: ~70% CPU load at the normal rate, ~140% during peaks
+void generator_default_config(GeneratorConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->count = 100000;
+    config->seed = 1;
+    config->arrival_process = ARRIVAL_POISSON;
+    config->rate = 100.0;
+    config->peak_rate = 200.0;
+    config->normal_dwell_ms = 10000.0;
+    config->peak_dwell_ms = 2000.0;
+    config->burst_distribution = BURST_EXPONENTIAL;
+    config->lognormal_sigma = 1.0;
+    config->pareto_alpha = 2.5;
+    config->foreground_share = 0.8;
+    config->burst_scale = 1.0;
+}
+
+// Index of value in names[], -1 if absent
+int generator_lookup_name(const char* value, const char* const* names, int n) {
+    for (int i = 0; i < n; i++) {
+        if (strcmp(value, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+void generator_print_options(void) {
+    fprintf(stderr, "  --count N              tasks to generate (default 100000)\n");
+    fprintf(stderr, "  --seed N               random seed (default 1)\n");
+    fprintf(stderr, "  --arrival poisson|mmpp arrival process (default poisson)\n");
+    fprintf(stderr, "  --rate R               arrivals/second, MMPP normal state (default 100)\n");
+    fprintf(stderr, "  --peak-rate R          MMPP peak-state arrivals/second (default 200)\n");
+    fprintf(stderr, "  --normal-dwell MS      MMPP mean normal period (default 10000)\n");
+    fprintf(stderr, "  --peak-dwell MS        MMPP mean peak period (default 2000)\n");
+    fprintf(stderr, "  --burst exponential|lognormal|pareto (default exponential)\n");
+    fprintf(stderr, "  --sigma S              lognormal shape (default 1.0)\n");
+    fprintf(stderr, "  --alpha A              Pareto tail index, > 1 (default 2.5)\n");
+    fprintf(stderr, "  --foreground-share F   fraction of POS tasks (default 0.8)\n");
+    fprintf(stderr, "  --burst-scale X        multiply every mean burst (default 1.0)\n");
+}
+
+// Apply one "--option value" pair to config. Returns 1 if it was a
+// generator option, 0 if not; bad names surface in generator_check_config.
+int generator_apply_option(GeneratorConfig* config, const char* opt, const char* value) {
+    if (strcmp(opt, "--count") == 0) {
+        config->count = strtoull(value, NULL, 10);
+    } else if (strcmp(opt, "--seed") == 0) {
+        config->seed = strtoull(value, NULL, 10);
+    } else if (strcmp(opt, "--arrival") == 0) {
+        config->arrival_process = generator_lookup_name(value, arrival_process_names, 2);
+    } else if (strcmp(opt, "--rate") == 0) {
+        config->rate = atof(value);
+    } else if (strcmp(opt, "--peak-rate") == 0) {
+        config->peak_rate = atof(value);
+    } else if (strcmp(opt, "--normal-dwell") == 0) {
+        config->normal_dwell_ms = atof(value);
+    } else if (strcmp(opt, "--peak-dwell") == 0) {
+        config->peak_dwell_ms = atof(value);
+    } else if (strcmp(opt, "--burst") == 0) {
+        config->burst_distribution = generator_lookup_name(value, burst_distribution_names, 3);
+    } else if (strcmp(opt, "--sigma") == 0) {
+        config->lognormal_sigma = atof(value);
+    } else if (strcmp(opt, "--alpha") == 0) {
+        config->pareto_alpha = atof(value);
+    } else if (strcmp(opt, "--foreground-share") == 0) {
+        config->foreground_share = atof(value);
+    } else if (strcmp(opt, "--burst-scale") == 0) {
+        config->burst_scale = atof(value);
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int generator_check_config(const GeneratorConfig* config) {
+    if (config->arrival_process < 0 || config->burst_distribution < 0) {
+        fprintf(stderr, "generator: unknown arrival process or burst distribution\n");
+        return -1;
+    }
+    if (config->rate <= 0 || (config->arrival_process == ARRIVAL_MMPP &&
+        (config->peak_rate <= 0 || config->normal_dwell_ms <= 0 || config->peak_dwell_ms <= 0))) {
+        fprintf(stderr, "generator: arrival rates and MMPP dwell times must be positive\n");
+        return -1;
+    }
+    if (config->burst_distribution == BURST_PARETO && config->pareto_alpha <= 1.0) {
+        fprintf(stderr, "generator: Pareto alpha must be > 1 for a finite mean burst\n");
+        return -1;
+    }
+    if (config->lognormal_sigma <= 0 || config->burst_scale <= 0) {
+        fprintf(stderr, "generator: lognormal sigma and burst scale must be positive\n");
+        return -1;
+    }
+    if (config->foreground_share < 0 || config->foreground_share > 1) {
+        fprintf(stderr, "generator: foreground share must be within [0, 1]\n");
+        return -1;
+    }
+    return 0;
+}
+
+typedef struct {
+    GeneratorConfig config;
+    Rng rng;
+    uint64_t generated;
+    double clock_ns;            // arrival time of the last task
+    int peak;                   // MMPP state: 0 = normal, 1 = peak
+    double state_end_ns;        // when the MMPP leaves its current state
+} Generator;
+
+void generator_init(Generator* gen, const GeneratorConfig* config) {
+    memset(gen, 0, sizeof(*gen));
+    gen->config = *config;
+    rng_seed(&gen->rng, config->seed);
+    if (config->arrival_process == ARRIVAL_MMPP) {
+        gen->state_end_ns = rng_exponential(&gen->rng, config->normal_dwell_ms * 1e6);
+    }
+}
+
+// Same config, but drawing from stream number stream of config->seed:
+// replications of one config get independent, individually reproducible traces
+void generator_init_stream(Generator* gen, const GeneratorConfig* config, uint64_t stream) {
+    generator_init(gen, config);
+    rng_seed_stream(&gen->rng, config->seed, stream);
+    if (config->arrival_process == ARRIVAL_MMPP) {
+        gen->state_end_ns = rng_exponential(&gen->rng, config->normal_dwell_ms * 1e6);
+    }
+}
+
+// Advance the clock by one interarrival gap. In MMPP mode a gap that would
+// cross a state change is cut at the boundary and redrawn at the new rate
+// (valid because exponential gaps are memoryless).
+void generator_next_arrival(Generator* gen) {
+    const GeneratorConfig* config = &gen->config;
+    if (config->arrival_process != ARRIVAL_MMPP) {
+        gen->clock_ns += rng_exponential(&gen->rng, 1e9 / config->rate);
+        return;
+    }
+    for (;;) {
+        double rate = gen->peak ? config->peak_rate : config->rate;
+        double gap = rng_exponential(&gen->rng, 1e9 / rate);
+        if (gen->clock_ns + gap <= gen->state_end_ns) {
+            gen->clock_ns += gap;
+            return;
+        }
+        gen->clock_ns = gen->state_end_ns;
+        gen->peak = !gen->peak;
+        double dwell_ms = gen->peak ? config->peak_dwell_ms : config->normal_dwell_ms;
+        gen->state_end_ns += rng_exponential(&gen->rng, dwell_ms * 1e6);
+    }
+}
+
+const GeneratorClass* generator_pick_class(Generator* gen) {
+    int foreground = rng_uniform(&gen->rng) < gen->config.foreground_share;
+    double pick = rng_uniform(&gen->rng);
+    const GeneratorClass* last = NULL;
+    for (int i = 0; i < GENERATOR_CLASS_COUNT; i++) {
+        const GeneratorClass* c = &generator_classes[i];
+        if ((task_kinds[c->kind].task_class == TASK_CLASS_FOREGROUND) != foreground) continue;
+        last = c;
+        pick -= c->weight;
+        if (pick <= 0) break;
+    }
+    return last;
+}
+
+double generator_burst_ms(Generator* gen, double mean_ms) {
+    const GeneratorConfig* config = &gen->config;
+    switch (config->burst_distribution) {
+        case BURST_LOGNORMAL:
+            return rng_lognormal(&gen->rng, mean_ms, config->lognormal_sigma);
+        case BURST_PARETO:
+            return rng_pareto(&gen->rng, mean_ms, config->pareto_alpha);
+        default:
+            return rng_exponential(&gen->rng, mean_ms);
+    }
+}
+
+// Produce the next task; returns 0 once config.count tasks were generated
+int generator_next(Generator* gen, WorkloadRecord* rec) {
+    if (gen->generated >= gen->config.count) return 0;
+
+    generator_next_arrival(gen);
+    const GeneratorClass* c = generator_pick_class(gen);
+    double burst_ms = generator_burst_ms(gen, c->mean_burst_ms * gen->config.burst_scale);
+    double burst_ns = burst_ms * 1e6;
+    if (burst_ns < GENERATOR_MIN_BURST_NS) burst_ns = GENERATOR_MIN_BURST_NS;
+    if (burst_ns > GENERATOR_MAX_BURST_NS) burst_ns = GENERATOR_MAX_BURST_NS;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->pid = (uint32_t)(gen->generated + 1);
+    rec->kind = (uint8_t)c->kind;
+    rec->priority = (uint8_t)c->priority;
+    rec->arrival_ns = (int64_t)llround(gen->clock_ns);
+    rec->burst_ns = (int64_t)llround(burst_ns);
+    gen->generated++;
+    return 1;
+}
+
+#endif // PRIMECART_GENERATOR_H
@@ -0,0 +1,142 @@
+// primecart_heap.h
+// Indexed binary min-heap of process indices, used as an ordered ready queue.
+//
+// pos[] maps each process index to its slot so a queued task can be removed
+// in O(log n) without searching; push/pop/peek are O(log n)/O(1).
+#ifndef PRIMECART_HEAP_H
+#define PRIMECART_HEAP_H
+
+#include "primecart_sched.h"
+
+typedef struct {
+    SchedSim* sim;   // key fields are read live from sim->procs
+    TaskOrder before;
+    int* items;      // heap array of process indices
+    int* pos;        // pos[task] = slot in items, -1 if not queued
+    int count;
+    int capacity;    // number of process indices pos[] can hold (grows)
+} TaskHeap;
+
+void heap_init(TaskHeap* h, SchedSim* sim, TaskOrder before, int capacity) {
+    if (capacity < 1) capacity = 1;
+    h->sim = sim;
+    h->before = before;
+    h->items = (int*)malloc(sizeof(int) * capacity);
+    h->pos = (int*)malloc(sizeof(int) * capacity);
+    if (h->items == NULL || h->pos == NULL) {
+        perror("heap_init: malloc failed");
+        exit(1);
+    }
+    for (int i = 0; i < capacity; i++) {
+        h->pos[i] = -1;
+    }
+    h->count = 0;
+    h->capacity = capacity;
+}
+
+void heap_free(TaskHeap* h) {
+    free(h->items);
+    free(h->pos);
+    h->items = NULL;
+    h->pos = NULL;
+    h->count = 0;
+}
+
+int heap_less(const TaskHeap* h, int a, int b) {
+    const LinuxProcess* procs = h->sim->procs;
+    return h->before(&procs[a], &procs[b]);
+}
+
+void heap_place(TaskHeap* h, int slot, int task) {
+    h->items[slot] = task;
+    h->pos[task] = slot;
+}
+
+void heap_sift_up(TaskHeap* h, int slot) {
+    int task = h->items[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (!heap_less(h, task, h->items[parent])) break;
+        heap_place(h, slot, h->items[parent]);
+        slot = parent;
+    }
+    heap_place(h, slot, task);
+}
+
+void heap_sift_down(TaskHeap* h, int slot) {
+    int task = h->items[slot];
+    for (;;) {
+        int child = 2 * slot + 1;
+        if (child >= h->count) break;
+        if (child + 1 < h->count && heap_less(h, h->items[child + 1], h->items[child])) {
+            child++;
+        }
+        if (!heap_less(h, h->items[child], task)) break;
+        heap_place(h, slot, h->items[child]);
+        slot = child;
+    }
+    heap_place(h, slot, task);
+}
+
+// Grow pos[] and items[] to cover process indices below capacity; the
+// process table grows as tasks arrive, so the heap follows it
+void heap_reserve(TaskHeap* h, int capacity) {
+    if (capacity <= h->capacity) return;
+    int grown_capacity = h->capacity * 2 > capacity ? h->capacity * 2 : capacity;
+    int* items = (int*)realloc(h->items, sizeof(int) * grown_capacity);
+    if (items == NULL) {
+        perror("heap_reserve: realloc failed");
+        exit(1);
+    }
+    h->items = items;
+    int* pos = (int*)realloc(h->pos, sizeof(int) * grown_capacity);
+    if (pos == NULL) {
+        perror("heap_reserve: realloc failed");
+        exit(1);
+    }
+    h->pos = pos;
+    for (int i = h->capacity; i < grown_capacity; i++) {
+        h->pos[i] = -1;
+    }
+    h->capacity = grown_capacity;
+}
+
+void heap_push(TaskHeap* h, int task) {
+    heap_reserve(h, task + 1);
+    h->items[h->count] = task;
+    h->pos[task] = h->count;
+    h->count++;
+    heap_sift_up(h, h->count - 1);
+}
+
+// Best task without removing it, -1 if empty
+int heap_peek(const TaskHeap* h) {
+    return h->count > 0 ? h->items[0] : -1;
+}
+
+// Remove a queued task from anywhere in the heap
+void heap_remove(TaskHeap* h, int task) {
+    int slot = h->pos[task];
+    h->pos[task] = -1;
+    h->count--;
+    if (slot == h->count) return;
+
+    h->items[slot] = h->items[h->count];
+    h->pos[h->items[slot]] = slot;
+    if (slot > 0 && heap_less(h, h->items[slot], h->items[(slot - 1) / 2])) {
+        heap_sift_up(h, slot);
+    } else {
+        heap_sift_down(h, slot);
+    }
+}
+
+// Remove and return the best task, -1 if empty
+int heap_pop(TaskHeap* h) {
+    int task = heap_peek(h);
+    if (task != -1) {
+        heap_remove(h, task);
+    }
+    return task;
+}
+
+#endif // PRIMECART_HEAP_H
@@ -0,0 +1,139 @@
+// primecart_histogram.h
+// Fixed-memory latency histogram in the HDR style.
+//
+// Values (ns) below HIST_SUB_BUCKETS are counted exactly; above that every
+// power of two is split into HIST_SUB_BUCKETS / 2 equal sub-buckets, so a
+// recorded value is off by less than 1 / (HIST_SUB_BUCKETS / 2) of itself
+// (under 1.6%) across the whole 64-bit range. Recording is one array
+// increment, the footprint never grows, and two histograms merge by adding
+// their counts, which is how per-thread or per-run results are combined.
+// The mean and variance are kept exactly alongside (Welford's update, and
+// Chan's formula when merging), so no sample is ever needed twice.
+#ifndef PRIMECART_HISTOGRAM_H
+#define PRIMECART_HISTOGRAM_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#define HIST_SUB_BITS     7
+#define HIST_SUB_BUCKETS  (1 << HIST_SUB_BITS)                // 128
+#define HIST_HALF_BUCKETS (HIST_SUB_BUCKETS / 2)              // 64 per power of two
+#define HIST_BUCKETS      (HIST_SUB_BUCKETS + (64 - HIST_SUB_BITS) * HIST_HALF_BUCKETS)
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    double sum;               // exact mean without overflowing 64 bits
+    double m2;                // sum of squared deviations from the mean
+} Histogram;
+
+void hist_init(Histogram* h) {
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+int hist_index(uint64_t value) {
+    if (value < HIST_SUB_BUCKETS) return (int)value;
+    int magnitude = 63 - __builtin_clzll(value);              // >= HIST_SUB_BITS
+    int shift = magnitude - (HIST_SUB_BITS - 1);
+    return HIST_SUB_BUCKETS + (magnitude - HIST_SUB_BITS) * HIST_HALF_BUCKETS
+         + (int)((value >> shift) - HIST_HALF_BUCKETS);
+}
+
+// Largest value that lands in bucket index
+uint64_t hist_bucket_high(int index) {
+    if (index < HIST_SUB_BUCKETS) return (uint64_t)index;
+    int above = index - HIST_SUB_BUCKETS;
+    int magnitude = above / HIST_HALF_BUCKETS + HIST_SUB_BITS;
+    int shift = magnitude - (HIST_SUB_BITS - 1);
+    uint64_t low = (uint64_t)(above % HIST_HALF_BUCKETS + HIST_HALF_BUCKETS) << shift;
+    return low + ((1ULL << shift) - 1);
+}
+
+void hist_record(Histogram* h, uint64_t value) {
+    double before = h->count > 0 ? h->sum / h->count : 0.0;
+    h->counts[hist_index(value)]++;
+    h->count++;
+    h->sum += (double)value;
+    h->m2 += ((double)value - before) * ((double)value - h->sum / h->count);
+    if (value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+}
+
+// dst += src
+void hist_merge(Histogram* dst, const Histogram* src) {
+    if (src->count == 0) return;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    if (dst->count > 0) {
+        double delta = src->sum / src->count - dst->sum / dst->count;
+        dst->m2 += delta * delta * ((double)dst->count * src->count / (dst->count + src->count));
+    }
+    dst->m2 += src->m2;
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+}
+
+double hist_mean(const Histogram* h) {
+    return h->count > 0 ? h->sum / h->count : 0.0;
+}
+
+// Sample standard deviation, 0 with fewer than two values
+double hist_stddev(const Histogram* h) {
+    return h->count > 1 ? sqrt(h->m2 / (h->count - 1)) : 0.0;
+}
+
+// Nearest-rank percentile, reported as the top of its bucket (never above
+// the largest recorded value); 0 if empty
+uint64_t hist_percentile(const Histogram* h, double percentile) {
+    if (h->count == 0) return 0;
+    uint64_t rank = (uint64_t)ceil(percentile / 100.0 * h->count);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            uint64_t high = hist_bucket_high(i);
+            return high < h->max ? high : h->max;
+        }
+    }
+    return h->max;
+}
+
+// Distribution in power-of-two rows from the smallest to the largest
+// value, with a bar scaled to the fullest row; values shown in us
+void hist_print_distribution(const Histogram* h, const char* indent) {
+    if (h->count == 0) return;
+    uint64_t rows[65];
+    int first = 63 - __builtin_clzll(h->min | 1);
+    int last = 63 - __builtin_clzll(h->max | 1);
+    uint64_t fullest = 1;
+    memset(rows, 0, sizeof(rows));
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        if (h->counts[i] == 0) continue;
+        uint64_t high = hist_bucket_high(i);
+        rows[63 - __builtin_clzll(high | 1)] += h->counts[i];
+    }
+    for (int r = first; r <= last; r++) {
+        if (rows[r] > fullest) fullest = rows[r];
+    }
+    for (int r = first; r <= last; r++) {
+        char bar[41];
+        int width = (int)(rows[r] * 40 / fullest);
+        if (width == 0 && rows[r] > 0) width = 1;
+        memset(bar, '#', width);
+        bar[width] = '\0';
+        printf("%s%10.3f - %-10.3f us %10llu %6.2f%% |%s\n", indent,
+               (double)(1ULL << r) / 1000.0, (double)((2ULL << r) - 1) / 1000.0,
+               (unsigned long long)rows[r], rows[r] * 100.0 / h->count, bar);
+    }
+}
+
+#endif // PRIMECART_HISTOGRAM_H
@@ -0,0 +1,134 @@
+// primecart_host.h
+// Host latency and throughput figures behind the simulated switch cost and
+// the PRIMECART THRESHOLD ANALYSIS rows.
+//
+// Without a profile every figure is the Ubuntu 22.04 reference value below.
+// The probe program measures the real host and writes a profile file; the
+// simulators load it with --host-profile FILE. A profile holds only the
+// figures that were measured, one "key value" line each, so probes of
+// different kinds can update the same file and anything never measured
+// keeps its reference value.
+#ifndef PRIMECART_HOST_H
+#define PRIMECART_HOST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <errno.h>
+
+// Linux performance characteristics (reference figures)
+#define CONTEXT_SWITCH_LINUX 0.004    // 4 μs in ms
+#define INTERRUPT_LATENCY_LINUX 0.080 // 80 μs in ms
+#define SCHEDULING_JITTER_LINUX 0.0015 // 1.5 ms
+#define IPC_THROUGHPUT_LINUX 950.0    // MB/s
+
+// HostProfile.measured bits
+#define HOST_MEASURED_SWITCH    0x1
+#define HOST_MEASURED_LATENCY   0x2
+#define HOST_MEASURED_JITTER    0x4
+#define HOST_MEASURED_IPC       0x8
+
+typedef struct {
+    double context_switch_ms;    // process switch: pinned pipe ping-pong, median
+    double thread_switch_ms;     // thread switch: pinned futex ping-pong, median
+    double interrupt_latency_ms; // periodic timer wake-up, p99
+    double scheduling_jitter_ms; // periodic timer wake-up, p99.9 - p50
+    double ipc_throughput_mbps;
+    unsigned measured;           // HOST_MEASURED_*
+    char host[64];               // where the figures were measured
+    char date[32];
+    const char* path;            // file loaded from, NULL = reference figures
+} HostProfile;
+
+// The figures every simulation uses; only replaced before runs start
+HostProfile sim_host = {
+    CONTEXT_SWITCH_LINUX, CONTEXT_SWITCH_LINUX, INTERRUPT_LATENCY_LINUX,
+    SCHEDULING_JITTER_LINUX, IPC_THROUGHPUT_LINUX, 0, "", "", NULL
+};
+
+typedef struct {
+    const char* key;
+    size_t offset;
+    unsigned bit;
+} HostProfileField;
+
+#define HOST_PROFILE_FIELD_COUNT 5
+
+const HostProfileField host_profile_fields[HOST_PROFILE_FIELD_COUNT] = {
+    {"context_switch_ms",    offsetof(HostProfile, context_switch_ms),    HOST_MEASURED_SWITCH},
+    {"thread_switch_ms",     offsetof(HostProfile, thread_switch_ms),     HOST_MEASURED_SWITCH},
+    {"interrupt_latency_ms", offsetof(HostProfile, interrupt_latency_ms), HOST_MEASURED_LATENCY},
+    {"scheduling_jitter_ms", offsetof(HostProfile, scheduling_jitter_ms), HOST_MEASURED_JITTER},
+    {"ipc_throughput_mbps",  offsetof(HostProfile, ipc_throughput_mbps),  HOST_MEASURED_IPC}
+};
+
+// Start from the reference figures, then apply every key the file holds.
+// Returns 0 on success, -1 if the file cannot be read or a line is bad.
+int host_profile_load(HostProfile* profile, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "host profile %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    HostProfile loaded = {
+        CONTEXT_SWITCH_LINUX, CONTEXT_SWITCH_LINUX, INTERRUPT_LATENCY_LINUX,
+        SCHEDULING_JITTER_LINUX, IPC_THROUGHPUT_LINUX, 0, "", "", path
+    };
+    char line[256];
+    int line_no = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_no++;
+        char key[64];
+        char value[128];
+        if (line[0] == '#' || sscanf(line, "%63s %127[^\n]", key, value) != 2) continue;
+        if (strcmp(key, "host") == 0) {
+            sscanf(line, "%*s %63[^\n]", loaded.host);
+            continue;
+        }
+        if (strcmp(key, "date") == 0) {
+            sscanf(line, "%*s %31[^\n]", loaded.date);
+            continue;
+        }
+        for (int f = 0; f < HOST_PROFILE_FIELD_COUNT; f++) {
+            if (strcmp(key, host_profile_fields[f].key) != 0) continue;
+            char* end;
+            double v = strtod(value, &end);
+            if (end == value || v <= 0) {
+                fprintf(stderr, "host profile %s:%d: bad value for %s\n", path, line_no, key);
+                fclose(file);
+                return -1;
+            }
+            *(double*)((char*)&loaded + host_profile_fields[f].offset) = v;
+            loaded.measured |= host_profile_fields[f].bit;
+        }
+        // Unknown keys are skipped: newer probes may write more figures
+    }
+    fclose(file);
+    *profile = loaded;
+    return 0;
+}
+
+// Write the measured figures of profile to path. Returns 0 on success.
+int host_profile_save(const HostProfile* profile, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "host profile %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    fprintf(file, "# PrimeCart host profile, written by probe; read with --host-profile\n");
+    if (profile->host[0]) fprintf(file, "host %s\n", profile->host);
+    if (profile->date[0]) fprintf(file, "date %s\n", profile->date);
+    for (int f = 0; f < HOST_PROFILE_FIELD_COUNT; f++) {
+        if (!(profile->measured & host_profile_fields[f].bit)) continue;
+        fprintf(file, "%s %.6f\n", host_profile_fields[f].key,
+                *(const double*)((const char*)profile + host_profile_fields[f].offset));
+    }
+    if (fclose(file) != 0) {
+        fprintf(stderr, "host profile %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+#endif // PRIMECART_HOST_H
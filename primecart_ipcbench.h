@@ -0,0 +1,438 @@
+// primecart_ipcbench.h
+// POS-to-LPUS transfer benchmark over four IPC mechanisms: a named FIFO,
+// a Unix stream socket, a shared-memory ring polled by both sides, and the
+// same ring with eventfd wake-ups so neither side spins.
+//
+// A channel carries bytes one way between a parent and a forked child.
+// Messages are fixed-size and carry a sequence number the receiver checks,
+// so a broken transport fails the run instead of reporting a fast number.
+// "Batch" is how many messages move per send: one write() for the fd
+// transports, one publish plus one signal for the rings.
+//
+// Needs _GNU_SOURCE (eventfd, mkfifo helpers) before the first system
+// header; include after primecart_probe.h (probe_now_ns, Histogram).
+#ifndef PRIMECART_IPCBENCH_H
+#define PRIMECART_IPCBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <sys/wait.h>
+
+#include "primecart_probe.h"
+
+#define IPC_FIFO     0
+#define IPC_UNIX     1
+#define IPC_SHM      2 // shared-memory ring, both sides poll (sched_yield)
+#define IPC_EVENTFD  3 // shared-memory ring, eventfd wake-ups
+#define IPC_TRANSPORT_COUNT 4
+
+const char* ipc_transport_names[IPC_TRANSPORT_COUNT] = {
+    "FIFO", "Unix socket", "Shared memory", "Shm + eventfd"
+};
+
+#define IPC_RING_BYTES     (1 << 20) // power of two
+#define IPC_MIN_MESSAGE    8         // room for the sequence number
+
+// Single-producer single-consumer byte ring in a MAP_SHARED page set;
+// head and tail only grow, their difference is the fill level
+typedef struct {
+    uint64_t head;            // consumer position
+    char pad1[56];
+    uint64_t tail;            // producer position
+    char pad2[56];
+    char data[IPC_RING_BYTES];
+} IpcRing;
+
+typedef struct {
+    int kind;                 // IPC_*
+    int read_fd;              // FIFO / socket ends, -1 when unused
+    int write_fd;
+    char path[64];            // FIFO, unlinked once both sides opened it
+    IpcRing* ring;            // IPC_SHM / IPC_EVENTFD
+    int data_efd;             // IPC_EVENTFD: bytes published
+    int space_efd;            // IPC_EVENTFD: bytes consumed
+} IpcChannel;
+
+void ipc_channel_close(IpcChannel* ch) {
+    if (ch->read_fd >= 0) close(ch->read_fd);
+    if (ch->write_fd >= 0) close(ch->write_fd);
+    if (ch->data_efd >= 0) close(ch->data_efd);
+    if (ch->space_efd >= 0) close(ch->space_efd);
+    if (ch->ring != NULL) munmap(ch->ring, sizeof(IpcRing));
+    ch->read_fd = ch->write_fd = ch->data_efd = ch->space_efd = -1;
+    ch->ring = NULL;
+}
+
+// Create the channel before fork(). Returns 0 on success.
+int ipc_channel_open(IpcChannel* ch, int kind) {
+    memset(ch, 0, sizeof(*ch));
+    ch->kind = kind;
+    ch->read_fd = -1;
+    ch->write_fd = -1;
+    ch->data_efd = -1;
+    ch->space_efd = -1;
+    if (kind == IPC_FIFO) {
+        // mkstemp only reserves the name; the FIFO replaces the file
+        snprintf(ch->path, sizeof(ch->path), "/tmp/primecart_fifo_XXXXXX");
+        int fd = mkstemp(ch->path);
+        if (fd < 0) {
+            perror("ipc: mkstemp failed");
+            return -1;
+        }
+        close(fd);
+        unlink(ch->path);
+        if (mkfifo(ch->path, 0600) != 0) {
+            perror("ipc: mkfifo failed");
+            return -1;
+        }
+        return 0;
+    }
+    if (kind == IPC_UNIX) {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+            perror("ipc: socketpair failed");
+            return -1;
+        }
+        ch->write_fd = sv[0];
+        ch->read_fd = sv[1];
+        return 0;
+    }
+    ch->ring = (IpcRing*)mmap(NULL, sizeof(IpcRing), PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (ch->ring == MAP_FAILED) {
+        perror("ipc: mmap failed");
+        ch->ring = NULL;
+        return -1;
+    }
+    if (kind == IPC_EVENTFD) {
+        ch->data_efd = eventfd(0, 0);
+        ch->space_efd = eventfd(0, 0);
+        if (ch->data_efd < 0 || ch->space_efd < 0) {
+            perror("ipc: eventfd failed");
+            ipc_channel_close(ch);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// After fork(): keep this side's end (sender = 1 for the writing side).
+// Returns 0 on success.
+int ipc_channel_attach(IpcChannel* ch, int sender) {
+    if (ch->kind == IPC_FIFO) {
+        int fd = open(ch->path, sender ? O_WRONLY : O_RDONLY);
+        if (fd < 0) {
+            perror("ipc: cannot open FIFO");
+            return -1;
+        }
+        if (sender) ch->write_fd = fd; else ch->read_fd = fd;
+        return 0;
+    }
+    if (ch->kind == IPC_UNIX) {
+        close(sender ? ch->read_fd : ch->write_fd);
+        if (sender) ch->read_fd = -1; else ch->write_fd = -1;
+    }
+    return 0;
+}
+
+// Remove the FIFO's name once both sides have it open (parent only)
+void ipc_channel_unlink(IpcChannel* ch) {
+    if (ch->kind == IPC_FIFO && ch->path[0]) {
+        unlink(ch->path);
+        ch->path[0] = '\0';
+    }
+}
+
+void ipc_signal(int efd) {
+    uint64_t one = 1;
+    if (write(efd, &one, sizeof(one)) != (ssize_t)sizeof(one)) {
+        perror("ipc: eventfd write failed");
+        exit(1);
+    }
+}
+
+void ipc_wait(int efd) {
+    uint64_t count;
+    if (read(efd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+        perror("ipc: eventfd read failed");
+        exit(1);
+    }
+}
+
+// Send len bytes (one batch). Returns 0 on success.
+int ipc_send(IpcChannel* ch, const char* buf, size_t len) {
+    if (ch->ring == NULL) {
+        while (len > 0) {
+            ssize_t n = write(ch->write_fd, buf, len);
+            if (n <= 0) return -1;
+            buf += n;
+            len -= (size_t)n;
+        }
+        return 0;
+    }
+    IpcRing* ring = ch->ring;
+    uint64_t tail = ring->tail;
+    while (len > 0) {
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        size_t space = IPC_RING_BYTES - (size_t)(tail - head);
+        if (space == 0) {
+            if (ch->kind == IPC_EVENTFD) {
+                ipc_signal(ch->data_efd); // the consumer may be asleep on a partial batch
+                ipc_wait(ch->space_efd);
+            } else {
+                sched_yield();
+            }
+            continue;
+        }
+        size_t offset = (size_t)(tail & (IPC_RING_BYTES - 1));
+        size_t n = len < space ? len : space;
+        if (n > IPC_RING_BYTES - offset) n = IPC_RING_BYTES - offset;
+        memcpy(ring->data + offset, buf, n);
+        tail += n;
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+        buf += n;
+        len -= n;
+    }
+    if (ch->kind == IPC_EVENTFD) ipc_signal(ch->data_efd);
+    return 0;
+}
+
+// Receive exactly len bytes. Returns 0 on success, -1 on EOF or error.
+int ipc_recv(IpcChannel* ch, char* buf, size_t len) {
+    if (ch->ring == NULL) {
+        while (len > 0) {
+            ssize_t n = read(ch->read_fd, buf, len);
+            if (n <= 0) return -1;
+            buf += n;
+            len -= (size_t)n;
+        }
+        return 0;
+    }
+    IpcRing* ring = ch->ring;
+    uint64_t head = ring->head;
+    while (len > 0) {
+        uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        size_t avail = (size_t)(tail - head);
+        if (avail == 0) {
+            if (ch->kind == IPC_EVENTFD) {
+                ipc_wait(ch->data_efd);
+            } else {
+                sched_yield();
+            }
+            continue;
+        }
+        size_t offset = (size_t)(head & (IPC_RING_BYTES - 1));
+        size_t n = len < avail ? len : avail;
+        if (n > IPC_RING_BYTES - offset) n = IPC_RING_BYTES - offset;
+        memcpy(buf, ring->data + offset, n);
+        head += n;
+        __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+        if (ch->kind == IPC_EVENTFD) ipc_signal(ch->space_efd);
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark runs
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int kind;
+    size_t message;           // bytes per message
+    int batch;                // messages per send
+    long long messages;       // transferred
+    double seconds;
+    double mbps;              // MB/s, MB = 2^20 bytes
+    double messages_per_s;
+    uint64_t latency_p50;     // one-way, ns, batch 1 ping-pong (0 = not measured)
+    uint64_t latency_p99;
+    int ok;                   // throughput measured
+} IpcResult;
+
+// Stamp message i of a batch with its sequence number
+void ipc_stamp(char* batch, size_t message, int count, uint64_t first) {
+    for (int i = 0; i < count; i++) {
+        uint64_t seq = first + (uint64_t)i;
+        memcpy(batch + (size_t)i * message, &seq, sizeof(seq));
+    }
+}
+
+int ipc_check(const char* batch, size_t message, int count, uint64_t first) {
+    for (int i = 0; i < count; i++) {
+        uint64_t seq;
+        memcpy(&seq, batch + (size_t)i * message, sizeof(seq));
+        if (seq != first + (uint64_t)i) return -1;
+    }
+    return 0;
+}
+
+// Fork a peer with a data channel (parent -> child) and a reply channel
+// (child -> parent). The child runs peer() and exits with its status.
+// Returns the child's pid, -1 on failure.
+pid_t ipc_start_peer(IpcChannel* data, IpcChannel* reply, int kind,
+                     int (*peer)(IpcChannel*, IpcChannel*, void*), void* arg) {
+    if (ipc_channel_open(data, kind) != 0) return -1;
+    if (ipc_channel_open(reply, kind) != 0) {
+        ipc_channel_unlink(data);
+        ipc_channel_close(data);
+        return -1;
+    }
+    pid_t child = fork();
+    if (child < 0) {
+        perror("ipc: fork failed");
+        ipc_channel_unlink(data);
+        ipc_channel_unlink(reply);
+        ipc_channel_close(data);
+        ipc_channel_close(reply);
+        return -1;
+    }
+    if (child == 0) {
+        // Same open order as the parent, or two FIFOs deadlock
+        if (ipc_channel_attach(data, 0) != 0 || ipc_channel_attach(reply, 1) != 0) _exit(1);
+        _exit(peer(data, reply, arg) == 0 ? 0 : 1);
+    }
+    if (ipc_channel_attach(data, 1) != 0 || ipc_channel_attach(reply, 0) != 0) {
+        kill(child, SIGKILL);
+        waitpid(child, NULL, 0);
+        return -1;
+    }
+    ipc_channel_unlink(data);
+    ipc_channel_unlink(reply);
+    return child;
+}
+
+// Reap the peer; 0 if it exited cleanly
+int ipc_finish_peer(pid_t child, IpcChannel* data, IpcChannel* reply) {
+    int status = 0;
+    ipc_channel_close(data);
+    ipc_channel_close(reply);
+    if (waitpid(child, &status, 0) != child) return -1;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+typedef struct {
+    size_t message;
+    int batch;
+    long long messages;
+} IpcStreamPlan;
+
+// Throughput receiver: check every batch, then acknowledge with one byte
+int ipc_stream_peer(IpcChannel* data, IpcChannel* reply, void* arg) {
+    const IpcStreamPlan* plan = (const IpcStreamPlan*)arg;
+    char* buffer = (char*)malloc(plan->message * plan->batch);
+    if (buffer == NULL) return -1;
+    int status = 0;
+    for (long long sent = 0; sent < plan->messages && status == 0; ) {
+        int count = plan->messages - sent < plan->batch ? (int)(plan->messages - sent) : plan->batch;
+        if (ipc_recv(data, buffer, plan->message * count) != 0
+            || ipc_check(buffer, plan->message, count, (uint64_t)sent) != 0) {
+            status = -1;
+        }
+        sent += count;
+    }
+    char ack = status == 0 ? 'k' : 'x';
+    if (ipc_send(reply, &ack, 1) != 0) status = -1;
+    free(buffer);
+    return status;
+}
+
+// Latency echo: return every message as received
+int ipc_echo_peer(IpcChannel* data, IpcChannel* reply, void* arg) {
+    size_t message = *(const size_t*)arg;
+    char* buffer = (char*)malloc(message);
+    if (buffer == NULL) return -1;
+    while (ipc_recv(data, buffer, message) == 0) {
+        if (ipc_send(reply, buffer, message) != 0) break;
+    }
+    free(buffer);
+    return 0;
+}
+
+// Stream messages in batches and time until the receiver has checked them all
+void ipc_measure_throughput(IpcResult* r, long long messages) {
+    IpcStreamPlan plan = { r->message, r->batch, messages };
+    IpcChannel data;
+    IpcChannel reply;
+    r->ok = 0;
+    pid_t child = ipc_start_peer(&data, &reply, r->kind, ipc_stream_peer, &plan);
+    if (child < 0) return;
+
+    char* buffer = (char*)malloc(r->message * r->batch);
+    if (buffer == NULL) {
+        perror("ipc: malloc failed");
+        exit(1);
+    }
+    memset(buffer, 0xA5, r->message * r->batch);
+    long long started = probe_now_ns();
+    int status = 0;
+    for (long long sent = 0; sent < messages && status == 0; ) {
+        int count = messages - sent < r->batch ? (int)(messages - sent) : r->batch;
+        ipc_stamp(buffer, r->message, count, (uint64_t)sent);
+        status = ipc_send(&data, buffer, r->message * count);
+        sent += count;
+    }
+    char ack = 0;
+    if (status == 0 && (ipc_recv(&reply, &ack, 1) != 0 || ack != 'k')) status = -1;
+    long long elapsed = probe_now_ns() - started;
+    free(buffer);
+    if (ipc_finish_peer(child, &data, &reply) != 0) status = -1;
+    if (status != 0 || elapsed <= 0) return;
+
+    r->messages = messages;
+    r->seconds = elapsed / 1e9;
+    r->mbps = (double)messages * r->message / (1 << 20) / r->seconds;
+    r->messages_per_s = messages / r->seconds;
+    r->ok = 1;
+}
+
+// Ping-pong single messages; half of each round trip is one transfer.
+// Returns 0 on success.
+int ipc_measure_latency(IpcResult* r, int rounds) {
+    IpcChannel data;
+    IpcChannel reply;
+    size_t message = r->message;
+    pid_t child = ipc_start_peer(&data, &reply, r->kind, ipc_echo_peer, &message);
+    if (child < 0) return -1;
+    char* buffer = (char*)calloc(1, message);
+    Histogram* latency = (Histogram*)malloc(sizeof(Histogram));
+    if (buffer == NULL || latency == NULL) {
+        perror("ipc: malloc failed");
+        exit(1);
+    }
+    hist_init(latency);
+    int status = 0;
+    for (int i = 0; i < rounds + PROBE_WARMUP_ROUNDS && status == 0; i++) {
+        long long started = probe_now_ns();
+        if (ipc_send(&data, buffer, message) != 0 || ipc_recv(&reply, buffer, message) != 0) {
+            status = -1;
+        } else if (i >= PROBE_WARMUP_ROUNDS) {
+            hist_record(latency, (uint64_t)(probe_now_ns() - started) / 2);
+        }
+    }
+    // Closing the data channel ends the echo loop (EOF, or a ring nobody feeds)
+    if (r->kind == IPC_SHM || r->kind == IPC_EVENTFD) kill(child, SIGKILL);
+    ipc_channel_close(&data);
+    ipc_channel_close(&reply);
+    waitpid(child, NULL, 0);
+    if (status == 0) {
+        r->latency_p50 = hist_percentile(latency, 50.0);
+        r->latency_p99 = hist_percentile(latency, 99.0);
+    }
+    free(buffer);
+    free(latency);
+    return status;
+}
+
+#endif // PRIMECART_IPCBENCH_H
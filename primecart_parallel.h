@@ -0,0 +1,184 @@
+// primecart_parallel.h
+// Many independent simulations at once: a worker pool and per-run summaries.
+//
+// Every run owns its SchedSim (process table, ready queues, policy state),
+// and the workload image and policy configs are only read while runs are in
+// flight, so runs share nothing mutable. Workers claim the next run index
+// with an atomic counter; there is no lock and no ordering between runs,
+// which is what lets the pool scale with the number of cores.
+#ifndef PRIMECART_PARALLEL_H
+#define PRIMECART_PARALLEL_H
+
+#include <pthread.h>
+#include <strings.h>
+
+#include "primecart_cli.h"
+
+// Headline metrics of one finished run; times in ms
+typedef struct {
+    long long tasks;          // completed tasks
+    double avg_wait;
+    double p99_wait;
+    double avg_response;
+    double p99_response;
+    double avg_turnaround;
+    double p99_turnaround;
+    double p99_class_response[TASK_CLASS_COUNT];
+    double utilization;       // % of all CPUs
+    double cpu_load;          // utilization plus context switch overhead, %
+    double throughput;        // tasks/second
+    double makespan;          // simulated time until the last completion
+    long long context_switches;
+    long long preemptions;
+    double switch_overhead;   // CPU time spent switching (and migrating), ms
+    double wall_seconds;      // host time the simulation took
+} SimSummary;
+
+// Every policy, by the name the drivers accept on the command line
+typedef struct {
+    const char* key;
+    const SchedPolicy* policy;
+} NamedPolicy;
+
+#define SIM_POLICY_COUNT 10
+
+const NamedPolicy sim_policies[SIM_POLICY_COUNT] = {
+    {"fcfs",     &FCFS_POLICY},
+    {"sjf",      &SJF_POLICY},
+    {"srtf",     &SRTF_POLICY},
+    {"rr",       &RR_POLICY},
+    {"priority", &PRIORITY_POLICY},
+    {"edf",      &EDF_POLICY},
+    {"cfs",      &CFS_POLICY},
+    {"mlfq",     &MLFQ_POLICY},
+    {"stride",   &STRIDE_POLICY},
+    {"lottery",  &LOTTERY_POLICY}
+};
+
+#define SIM_POLICY_NAMES "fcfs,sjf,srtf,rr,priority,edf,cfs,mlfq,stride,lottery"
+
+// Fill out[] from a comma-separated list of policy names, or with every
+// policy if list is NULL. Returns the count, -1 on an unknown name.
+int sim_parse_policy_list(const char* list, const SchedPolicy* out[SIM_POLICY_COUNT]) {
+    int count = 0;
+    if (list == NULL) {
+        for (int p = 0; p < SIM_POLICY_COUNT; p++) {
+            out[count++] = sim_policies[p].policy;
+        }
+        return count;
+    }
+    for (const char* name = list; *name; ) {
+        size_t len = strcspn(name, ",");
+        int found = -1;
+        for (int p = 0; p < SIM_POLICY_COUNT; p++) {
+            if (strlen(sim_policies[p].key) == len && strncasecmp(name, sim_policies[p].key, len) == 0) {
+                found = p;
+            }
+        }
+        if (found < 0) {
+            fprintf(stderr, "unknown policy '%.*s' (choose from %s)\n", (int)len, name, SIM_POLICY_NAMES);
+            return -1;
+        }
+        if (count == SIM_POLICY_COUNT) {
+            fprintf(stderr, "at most %d policies per run\n", SIM_POLICY_COUNT);
+            return -1;
+        }
+        out[count++] = sim_policies[found].policy;
+        name += len;
+        if (*name == ',') name++;
+    }
+    return count;
+}
+
+// Everything comes from the latency histograms, so the process table is
+// never scanned or sorted and streaming runs summarize the same way
+void sim_summarize(const SchedSim* sim, SimSummary* s) {
+    memset(s, 0, sizeof(*s));
+    long long n = sim->completed_count;
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        s->p99_class_response[c] = sim_latency_percentile(sim, c, SIM_METRIC_RESPONSE, 99.0);
+    }
+    s->tasks = n;
+    s->avg_wait = sim_latency_mean(sim, -1, SIM_METRIC_WAIT);
+    s->avg_response = sim_latency_mean(sim, -1, SIM_METRIC_RESPONSE);
+    s->avg_turnaround = sim_latency_mean(sim, -1, SIM_METRIC_TURNAROUND);
+    s->p99_wait = sim_latency_percentile(sim, -1, SIM_METRIC_WAIT, 99.0);
+    s->p99_response = sim_latency_percentile(sim, -1, SIM_METRIC_RESPONSE, 99.0);
+    s->p99_turnaround = sim_latency_percentile(sim, -1, SIM_METRIC_TURNAROUND, 99.0);
+
+    s->utilization = sim_cpu_utilization(sim);
+    if (sim->current_time > 0) {
+        s->cpu_load = (sim->total_burst_time + sim->total_switch_time) * 100.0 / ((double)sim->current_time * sim->ncpus);
+    }
+    s->throughput = sim->current_time > 0 ? n / (sim_ms(sim->current_time) / 1000.0) : 0.0;
+    s->makespan = sim_ms(sim->current_time);
+    s->context_switches = sim->total_context_switches;
+    s->preemptions = sim->total_preemptions;
+    s->switch_overhead = sim_ms(sim->total_switch_time);
+}
+
+// ---------------------------------------------------------------------------
+// Worker pool
+// ---------------------------------------------------------------------------
+
+typedef void (*ParallelJob)(void* ctx, int index);
+
+typedef struct {
+    ParallelJob job;
+    void* ctx;
+    int count;
+    int next;                 // next index to claim (atomic)
+} ParallelPool;
+
+void* parallel_worker(void* arg) {
+    ParallelPool* pool = (ParallelPool*)arg;
+    for (;;) {
+        int index = __atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED);
+        if (index >= pool->count) break;
+        pool->job(pool->ctx, index);
+    }
+    return NULL;
+}
+
+// Online CPUs, at least 1
+int parallel_default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Run job(ctx, i) for every i in [0, count) on up to threads threads and
+// wait for all of them. If threads cannot be created, the caller's thread
+// works through what is left.
+void parallel_run(ParallelJob job, void* ctx, int count, int threads) {
+    ParallelPool pool = { job, ctx, count, 0 };
+    if (threads > count) threads = count;
+    if (threads < 1) threads = 1;
+
+    pthread_t* workers = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+    if (workers == NULL) {
+        perror("parallel_run: malloc failed");
+        exit(1);
+    }
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        int rc = pthread_create(&workers[started], NULL, parallel_worker, &pool);
+        if (rc != 0) {
+            fprintf(stderr, "parallel_run: pthread_create failed: %s\n", strerror(rc));
+            break;
+        }
+        started++;
+    }
+    parallel_worker(&pool);
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    free(workers);
+}
+
+double parallel_elapsed(const struct timespec* since) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - since->tv_sec) + (now.tv_nsec - since->tv_nsec) / 1e9;
+}
+
+#endif // PRIMECART_PARALLEL_H
@@ -0,0 +1,963 @@
+// primecart_policies.h
+// Scheduling policies for the shared PrimeCart simulation core.
+#ifndef PRIMECART_POLICIES_H
+#define PRIMECART_POLICIES_H
+
+#include "primecart_sched.h"
+#include "primecart_heap.h"
+#include "primecart_rbtree.h"
+#include "primecart_rng.h"
+
+// ---------------------------------------------------------------------------
+// FIFO ready queue (FCFS, Round Robin): O(1) ring buffer
+// ---------------------------------------------------------------------------
+
+// Circular buffer of process indices. Capacity is a power of two so the
+// wrap is a mask; it doubles (rarely) when the backlog outgrows it, and
+// enqueue/dequeue never allocate.
+typedef struct {
+    int* items;
+    int head;      // slot of the front task
+    int size;
+    int capacity;
+} Queue;
+
+#define QUEUE_INITIAL_CAPACITY 1024
+
+Queue* create_queue() {
+    Queue* q = (Queue*)malloc(sizeof(Queue));
+    int* items = (int*)malloc(sizeof(int) * QUEUE_INITIAL_CAPACITY);
+    if (q == NULL || items == NULL) {
+        perror("create_queue: malloc failed");
+        exit(1);
+    }
+    q->items = items;
+    q->head = 0;
+    q->size = 0;
+    q->capacity = QUEUE_INITIAL_CAPACITY;
+    return q;
+}
+
+// Double the buffer, unwrapping the queue to start at slot 0
+void queue_grow(Queue* q) {
+    int capacity = q->capacity * 2;
+    int* items = (int*)malloc(sizeof(int) * capacity);
+    if (items == NULL) {
+        perror("queue_grow: malloc failed");
+        exit(1);
+    }
+    for (int i = 0; i < q->size; i++) {
+        items[i] = q->items[(q->head + i) & (q->capacity - 1)];
+    }
+    free(q->items);
+    q->items = items;
+    q->head = 0;
+    q->capacity = capacity;
+}
+
+void enqueue(Queue* q, int process_index) {
+    if (q->size == q->capacity) {
+        queue_grow(q);
+    }
+    q->items[(q->head + q->size) & (q->capacity - 1)] = process_index;
+    q->size++;
+}
+
+int dequeue(Queue* q) {
+    if (q->size == 0) return -1;
+
+    int process_index = q->items[q->head];
+    q->head = (q->head + 1) & (q->capacity - 1);
+    q->size--;
+    return process_index;
+}
+
+int is_queue_empty(Queue* q) {
+    return q->size == 0;
+}
+
+void destroy_queue(void* rq) {
+    Queue* q = (Queue*)rq;
+    free(q->items);
+    free(q);
+}
+
+void* fifo_create(SchedSim* sim) {
+    (void)sim;
+    return create_queue();
+}
+
+void fifo_enqueue(SchedSim* sim, void* rq, int task) {
+    (void)sim;
+    enqueue((Queue*)rq, task);
+}
+
+void fifo_requeue(SchedSim* sim, void* rq, int task, int reason) {
+    (void)sim;
+    (void)reason;
+    enqueue((Queue*)rq, task);
+}
+
+int fifo_select_next(SchedSim* sim, void* rq) {
+    (void)sim;
+    return dequeue((Queue*)rq);
+}
+
+// ---------------------------------------------------------------------------
+// Ordered ready queue (SJF, priority): indexed min-heap, O(log n) per decision
+// ---------------------------------------------------------------------------
+
+void heap_queue_destroy(void* rq) {
+    TaskHeap* h = (TaskHeap*)rq;
+    heap_free(h);
+    free(h);
+}
+
+void heap_queue_push(SchedSim* sim, void* rq, int task) {
+    (void)sim;
+    heap_push((TaskHeap*)rq, task);
+}
+
+void heap_queue_repush(SchedSim* sim, void* rq, int task, int reason) {
+    (void)sim;
+    (void)reason;
+    heap_push((TaskHeap*)rq, task);
+}
+
+int heap_queue_pop(SchedSim* sim, void* rq) {
+    (void)sim;
+    return heap_pop((TaskHeap*)rq);
+}
+
+void* heap_queue_create(SchedSim* sim, TaskOrder before) {
+    TaskHeap* h = (TaskHeap*)malloc(sizeof(TaskHeap));
+    heap_init(h, sim, before, sim->count);
+    return h;
+}
+
+// ---------------------------------------------------------------------------
+// FCFS: non-preemptive, strict arrival order
+// ---------------------------------------------------------------------------
+
+const SchedPolicy FCFS_POLICY = {
+    "FCFS", 0,
+    fifo_create, destroy_queue,
+    fifo_enqueue, fifo_select_next, NULL, fifo_requeue, NULL,
+    NULL, NULL
+};
+
+// ---------------------------------------------------------------------------
+// SJF: non-preemptive, shortest burst first, keyed on (burst, arrival).
+// The burst is predicted_burst, i.e. exact unless prediction is enabled.
+// ---------------------------------------------------------------------------
+
+int sjf_before(const LinuxProcess* a, const LinuxProcess* b) {
+    if (a->predicted_burst != b->predicted_burst) return a->predicted_burst < b->predicted_burst;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time;
+    return a->seq < b->seq;
+}
+
+void* sjf_create(SchedSim* sim) {
+    return heap_queue_create(sim, sjf_before);
+}
+
+const SchedPolicy SJF_POLICY = {
+    "SJF", 0,
+    sjf_create, heap_queue_destroy,
+    heap_queue_push, heap_queue_pop, NULL, heap_queue_repush, NULL,
+    NULL, NULL
+};
+
+// ---------------------------------------------------------------------------
+// SRTF: preemptive SJF, shortest (estimated) remaining time first
+// ---------------------------------------------------------------------------
+
+// Predicted burst minus the CPU time already used. A task that outlives
+// its prediction is assumed to need as long again as it has run so far.
+sim_time_t srtf_remaining_estimate(const LinuxProcess* p) {
+    sim_time_t executed = p->burst_time - p->remaining_time;
+    sim_time_t estimate = p->predicted_burst - executed;
+    return estimate > 0 ? estimate : executed;
+}
+
+int srtf_before(const LinuxProcess* a, const LinuxProcess* b) {
+    sim_time_t ra = srtf_remaining_estimate(a);
+    sim_time_t rb = srtf_remaining_estimate(b);
+    if (ra != rb) return ra < rb;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time;
+    return a->seq < b->seq;
+}
+
+void* srtf_create(SchedSim* sim) {
+    return heap_queue_create(sim, srtf_before);
+}
+
+int srtf_check_preempt(SchedSim* sim, void* rq, int running) {
+    int best = heap_peek((TaskHeap*)rq);
+    if (best == -1) return 0;
+    return srtf_before(&sim->procs[best], &sim->procs[running]);
+}
+
+#define SRTF_OVERRUN_GRANULARITY 0.5 // ms: lead a waiter needs over a task whose estimate is growing
+
+// A waiter's estimate is fixed, but once the running task outlives its
+// prediction its estimate grows with every ns it runs; it loses the CPU
+// once that estimate leads the queue head's by SRTF_OVERRUN_GRANULARITY.
+// Without the lead two overrunning tasks would trade the CPU every ns.
+// Exact estimates only shrink, so without prediction this never fires.
+sim_time_t srtf_preempt_time(SchedSim* sim, void* rq, int running) {
+    int best = heap_peek((TaskHeap*)rq);
+    if (!sim->predict_bursts || best == -1) return -1;
+    const LinuxProcess* p = &sim->procs[running];
+
+    // Executed time at which the running estimate has the lead against it
+    sim_time_t crossing = srtf_remaining_estimate(&sim->procs[best]) + MS_TO_NS(SRTF_OVERRUN_GRANULARITY);
+    if (crossing < p->predicted_burst) crossing = p->predicted_burst;
+    sim_time_t executed = p->burst_time - p->remaining_time;
+    return sim->current_time + (crossing - executed);
+}
+
+const SchedPolicy SRTF_POLICY = {
+    "SRTF", 0,
+    srtf_create, heap_queue_destroy,
+    heap_queue_push, heap_queue_pop, srtf_check_preempt, heap_queue_repush, NULL,
+    NULL, srtf_preempt_time
+};
+
+// ---------------------------------------------------------------------------
+// Round Robin: FIFO ready queue with a fixed time quantum
+// ---------------------------------------------------------------------------
+
+#define TIME_QUANTUM 5 // ms
+
+const SchedPolicy RR_POLICY = {
+    "Round Robin", MS_TO_NS(TIME_QUANTUM),
+    fifo_create, destroy_queue,
+    fifo_enqueue, fifo_select_next, NULL, fifo_requeue, NULL,
+    NULL, NULL
+};
+
+// ---------------------------------------------------------------------------
+// Preemptive priority: keyed on (priority, arrival); lower number runs first
+// ---------------------------------------------------------------------------
+
+// Aging: a waiting task gains one priority level per interval spent in the
+// ready queue, up to priority 1 (0 = no aging). Aging is continuous, so the
+// order of two waiting tasks is the order in which they would reach
+// priority 1, ready_since + (aged_priority - 1) * interval. That key is fixed
+// while a task waits: aging costs nothing per tick and never rescans.
+//
+// A task keeps the level it had aged to once it is picked: it runs at that
+// level, and if preempted or migrated it goes on aging from there instead of
+// from its base priority. Otherwise every waiter that ages past it, or any
+// POS arrival, would throw it out at once and its wait would start over,
+// so aging would not bound the wait.
+sim_time_t priority_aging_interval = 0;
+
+sim_time_t priority_aging_key(const LinuxProcess* p, sim_time_t ready_since) {
+    return ready_since + (p->aged_priority - 1) * priority_aging_interval;
+}
+
+// Priority after aging, as of now
+int priority_effective(const LinuxProcess* p, sim_time_t now) {
+    if (priority_aging_interval == 0) return p->priority;
+    int aged = p->aged_priority - (int)((now - p->ready_since) / priority_aging_interval);
+    return aged > 1 ? aged : 1;
+}
+
+int priority_before(const LinuxProcess* a, const LinuxProcess* b) {
+    if (priority_aging_interval > 0) {
+        sim_time_t ka = priority_aging_key(a, a->ready_since);
+        sim_time_t kb = priority_aging_key(b, b->ready_since);
+        if (ka != kb) return ka < kb;
+    }
+    if (a->priority != b->priority) return a->priority < b->priority;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time;
+    return a->seq < b->seq;
+}
+
+void* priority_create(SchedSim* sim) {
+    return heap_queue_create(sim, priority_before);
+}
+
+void priority_enqueue(SchedSim* sim, void* rq, int task) {
+    sim->procs[task].aged_priority = sim->procs[task].priority;
+    heap_push((TaskHeap*)rq, task);
+}
+
+// Freeze the level the task has aged to as it leaves the queue
+int priority_select_next(SchedSim* sim, void* rq) {
+    int task = heap_pop((TaskHeap*)rq);
+    if (task != -1) {
+        LinuxProcess* p = &sim->procs[task];
+        p->aged_priority = priority_effective(p, sim->current_time);
+    }
+    return task;
+}
+
+// The running task competes at the level it was picked with; a waiter
+// preempts only once it has aged to a strictly better one
+int priority_check_preempt(SchedSim* sim, void* rq, int running) {
+    int best = heap_peek((TaskHeap*)rq);
+    if (best == -1) return 0;
+    if (priority_aging_interval > 0) {
+        return priority_effective(&sim->procs[best], sim->current_time) < sim->procs[running].aged_priority;
+    }
+    return priority_before(&sim->procs[best], &sim->procs[running]);
+}
+
+// When the queue head will have aged to a level better than the running
+// task's, so it preempts without waiting for the next arrival. The head has
+// the earliest aging key, and
+// ready_since + (aged_priority - running + 1) * interval differs from that
+// key by the same amount for every waiter, so it is also the first to cross.
+sim_time_t priority_preempt_time(SchedSim* sim, void* rq, int running) {
+    int best = heap_peek((TaskHeap*)rq);
+    int running_priority = sim->procs[running].aged_priority;
+    if (priority_aging_interval == 0 || best == -1 || running_priority == 1) return -1;
+    const LinuxProcess* p = &sim->procs[best];
+    return p->ready_since + (p->aged_priority - running_priority + 1) * priority_aging_interval;
+}
+
+const SchedPolicy PRIORITY_POLICY = {
+    "Preemptive Priority", 0,
+    priority_create, heap_queue_destroy,
+    priority_enqueue, priority_select_next, priority_check_preempt, heap_queue_repush, NULL,
+    NULL, priority_preempt_time
+};
+
+// ---------------------------------------------------------------------------
+// EDF: preemptive earliest deadline first, keyed on (deadline, arrival)
+// ---------------------------------------------------------------------------
+
+int edf_before(const LinuxProcess* a, const LinuxProcess* b) {
+    if (a->deadline != b->deadline) return a->deadline < b->deadline;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time;
+    return a->seq < b->seq;
+}
+
+void* edf_create(SchedSim* sim) {
+    return heap_queue_create(sim, edf_before);
+}
+
+int edf_check_preempt(SchedSim* sim, void* rq, int running) {
+    int best = heap_peek((TaskHeap*)rq);
+    if (best == -1) return 0;
+    return edf_before(&sim->procs[best], &sim->procs[running]);
+}
+
+const SchedPolicy EDF_POLICY = {
+    "EDF", 0,
+    edf_create, heap_queue_destroy,
+    heap_queue_push, heap_queue_pop, edf_check_preempt, heap_queue_repush, NULL,
+    NULL, NULL
+};
+
+// ---------------------------------------------------------------------------
+// CFS: Linux Completely Fair Scheduler model. Ready tasks sit in a red-black
+// tree ordered by virtual runtime; the leftmost (least served) runs next.
+// ---------------------------------------------------------------------------
+
+// Linux defaults for one CPU; like the kernel, they grow by 1 + log2(CPUs)
+// (capped at 8 CPUs) on SMP
+#define CFS_TARGET_LATENCY    6.0  // ms: period in which every task runs once
+#define CFS_MIN_GRANULARITY   0.75 // ms: shortest slice, even when crowded
+#define CFS_WAKEUP_GRANULARITY 1.0 // ms: lead a waking task needs to preempt
+
+#define NICE_0_LOAD 1024
+
+// Kernel sched_prio_to_weight[]: each nice step is ~10% CPU share
+const int cfs_nice_to_weight[40] = {
+    /* -20 */ 88761, 71755, 56483, 46273, 36291,
+    /* -15 */ 29154, 23254, 18705, 14949, 11916,
+    /* -10 */  9548,  7620,  6100,  4904,  3906,
+    /*  -5 */  3121,  2501,  1991,  1586,  1277,
+    /*   0 */  1024,   820,   655,   526,   423,
+    /*   5 */   335,   272,   215,   172,   137,
+    /*  10 */   110,    87,    70,    56,    45,
+    /*  15 */    36,    29,    23,    18,    15
+};
+
+// PrimeCart priority 1 (POS) .. 5 (LPUS) maps to nice -10 .. +10
+int cfs_priority_to_nice(int priority) {
+    int nice = (priority - 3) * 5;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return nice;
+}
+
+typedef struct {
+    RbTree tree;
+    long long load;            // sum of queued weights
+    sim_time_t min_vruntime;   // monotonic floor of the rq's vruntimes
+} CfsRunqueue;
+
+sim_time_t cfs_tunable(const SchedSim* sim, double ms) {
+    int factor = 1;
+    for (int n = sim->ncpus < 8 ? sim->ncpus : 8; n > 1; n >>= 1) {
+        factor++;
+    }
+    return MS_TO_NS(ms) * factor;
+}
+
+// Weighted CPU time: delta scaled by NICE_0_LOAD / weight
+sim_time_t cfs_scale(sim_time_t delta, int weight) {
+    return delta * NICE_0_LOAD / weight;
+}
+
+int cfs_before(const LinuxProcess* a, const LinuxProcess* b) {
+    if (a->vruntime != b->vruntime) return a->vruntime < b->vruntime;
+    return a->seq < b->seq;
+}
+
+// Fold the CPU time a task has used since the last update into vruntime
+void cfs_update_vruntime(LinuxProcess* p) {
+    sim_time_t exec = p->burst_time - p->remaining_time;
+    p->vruntime += cfs_scale(exec - p->vruntime_exec, p->weight);
+    p->vruntime_exec = exec;
+}
+
+// min_vruntime follows the smaller of the running task and the leftmost
+// queued one, but never moves backwards
+void cfs_update_min_vruntime(SchedSim* sim, CfsRunqueue* rq) {
+    int curr = sim_rq_current(sim, rq);
+    int first = rbtree_first(&rq->tree);
+    sim_time_t vruntime = rq->min_vruntime;
+    if (curr != -1) {
+        cfs_update_vruntime(&sim->procs[curr]);
+        vruntime = sim->procs[curr].vruntime;
+    }
+    if (first != -1 && (curr == -1 || sim->procs[first].vruntime < vruntime)) {
+        vruntime = sim->procs[first].vruntime;
+    }
+    if (vruntime > rq->min_vruntime) {
+        rq->min_vruntime = vruntime;
+    }
+}
+
+void* cfs_create(SchedSim* sim) {
+    CfsRunqueue* rq = (CfsRunqueue*)malloc(sizeof(CfsRunqueue));
+    if (rq == NULL) {
+        perror("cfs_create: malloc failed");
+        exit(1);
+    }
+    rbtree_init(&rq->tree, sim, cfs_before);
+    rq->load = 0;
+    rq->min_vruntime = 0;
+    return rq;
+}
+
+void cfs_destroy(void* rq) {
+    CfsRunqueue* cfs = (CfsRunqueue*)rq;
+    rbtree_free(&cfs->tree);
+    free(cfs);
+}
+
+void cfs_insert(SchedSim* sim, CfsRunqueue* rq, int task) {
+    rbtree_insert(&rq->tree, task);
+    rq->load += sim->procs[task].weight;
+}
+
+// New tasks start level with the rq, so they neither starve nor monopolize it
+void cfs_enqueue(SchedSim* sim, void* rq, int task) {
+    CfsRunqueue* cfs = (CfsRunqueue*)rq;
+    LinuxProcess* p = &sim->procs[task];
+    cfs_update_min_vruntime(sim, cfs);
+    p->weight = cfs_nice_to_weight[cfs_priority_to_nice(p->priority) + 20];
+    p->vruntime = cfs->min_vruntime;
+    p->vruntime_exec = 0;
+    cfs_insert(sim, cfs, task);
+}
+
+void cfs_requeue(SchedSim* sim, void* rq, int task, int reason) {
+    CfsRunqueue* cfs = (CfsRunqueue*)rq;
+    LinuxProcess* p = &sim->procs[task];
+    cfs_update_vruntime(p);
+    if (reason == SCHED_REQUEUE_MIGRATE) {
+        // Keep its lag relative to the old rq, not the absolute value
+        p->vruntime += cfs->min_vruntime - p->vruntime_base;
+    }
+    cfs_insert(sim, cfs, task);
+}
+
+int cfs_select_next(SchedSim* sim, void* rq) {
+    CfsRunqueue* cfs = (CfsRunqueue*)rq;
+    cfs_update_min_vruntime(sim, cfs);
+    int task = rbtree_pop_first(&cfs->tree);
+    if (task == -1) return -1;
+    cfs->load -= sim->procs[task].weight;
+    sim->procs[task].vruntime_base = cfs->min_vruntime;
+    return task;
+}
+
+// Wakeup preemption: the leftmost task must be behind the running one by
+// more than the wakeup granularity (in the waking task's virtual time)
+int cfs_check_preempt(SchedSim* sim, void* rq, int running) {
+    CfsRunqueue* cfs = (CfsRunqueue*)rq;
+    int first = rbtree_first(&cfs->tree);
+    if (first == -1) return 0;
+    LinuxProcess* curr = &sim->procs[running];
+    cfs_update_vruntime(curr);
+    sim_time_t lead = curr->vruntime - sim->procs[first].vruntime;
+    return lead > cfs_scale(cfs_tunable(sim, CFS_WAKEUP_GRANULARITY), sim->procs[first].weight);
+}
+
+// The task's weighted share of the scheduling period: target latency, or
+// min granularity per task once the rq is too crowded for that
+sim_time_t cfs_time_slice(SchedSim* sim, void* rq, int task) {
+    CfsRunqueue* cfs = (CfsRunqueue*)rq;
+    sim_time_t latency = cfs_tunable(sim, CFS_TARGET_LATENCY);
+    sim_time_t min_granularity = cfs_tunable(sim, CFS_MIN_GRANULARITY);
+    long long nr_running = cfs->tree.count + 1;
+    long long weight = sim->procs[task].weight;
+
+    sim_time_t period = latency;
+    if (nr_running * min_granularity > period) {
+        period = nr_running * min_granularity;
+    }
+    sim_time_t slice = (sim_time_t)((double)period * weight / (cfs->load + weight));
+    return slice > min_granularity ? slice : min_granularity;
+}
+
+const SchedPolicy CFS_POLICY = {
+    "CFS", 0,
+    cfs_create, cfs_destroy,
+    cfs_enqueue, cfs_select_next, cfs_check_preempt, cfs_requeue, NULL,
+    cfs_time_slice, NULL
+};
+
+// ---------------------------------------------------------------------------
+// MLFQ: multi-level feedback queue. One FIFO per level; a bitmap of the
+// non-empty levels finds the highest ready level in O(1).
+// ---------------------------------------------------------------------------
+
+#define MLFQ_MAX_LEVELS 64
+
+typedef struct {
+    int levels;
+    sim_time_t quantum[MLFQ_MAX_LEVELS]; // time allotment per level, 0 = unlimited
+    sim_time_t boost_period;             // all tasks back to level 0, 0 = never
+} MlfqConfig;
+
+// Defaults: most POS bursts finish inside the 8 ms top level, 20 ms batch
+// jobs sink to the lower levels; a 200 ms boost keeps them from starving
+MlfqConfig mlfq_config = {
+    3, { MS_TO_NS(8), MS_TO_NS(16), MS_TO_NS(32) }, MS_TO_NS(200)
+};
+
+typedef struct {
+    Queue* level[MLFQ_MAX_LEVELS];
+    uint64_t ready;       // bit l set = level l has queued tasks
+    long long epoch;      // boost period the queue levels belong to
+    long long done[MLFQ_MAX_LEVELS][TASK_CLASS_COUNT]; // completions by final level
+} MlfqRunqueue;
+
+long long mlfq_epoch(const SchedSim* sim) {
+    return mlfq_config.boost_period > 0 ? sim->current_time / mlfq_config.boost_period : 0;
+}
+
+void* mlfq_create(SchedSim* sim) {
+    (void)sim;
+    MlfqRunqueue* rq = (MlfqRunqueue*)calloc(1, sizeof(MlfqRunqueue));
+    if (rq == NULL) {
+        perror("mlfq_create: calloc failed");
+        exit(1);
+    }
+    for (int l = 0; l < mlfq_config.levels; l++) {
+        rq->level[l] = create_queue();
+    }
+    return rq;
+}
+
+void mlfq_destroy(void* rq) {
+    MlfqRunqueue* mlfq = (MlfqRunqueue*)rq;
+    for (int l = 0; l < mlfq_config.levels; l++) {
+        destroy_queue(mlfq->level[l]);
+    }
+    free(mlfq);
+}
+
+void mlfq_set_level(SchedSim* sim, int task, int level) {
+    LinuxProcess* p = &sim->procs[task];
+    p->level = level;
+    p->level_epoch = mlfq_epoch(sim);
+    p->level_used = 0;
+}
+
+void mlfq_insert(SchedSim* sim, MlfqRunqueue* rq, int task) {
+    int level = sim->procs[task].level;
+    enqueue(rq->level[level], task);
+    rq->ready |= 1ULL << level;
+}
+
+// Priority boost, applied lazily at the first queue operation of a new
+// boost period: every queued task moves to level 0, in level order
+void mlfq_boost(SchedSim* sim, MlfqRunqueue* rq) {
+    long long epoch = mlfq_epoch(sim);
+    if (epoch == rq->epoch) return;
+    rq->epoch = epoch;
+    while (rq->ready & ~1ULL) {
+        int level = __builtin_ctzll(rq->ready & ~1ULL);
+        Queue* q = rq->level[level];
+        while (!is_queue_empty(q)) {
+            int task = dequeue(q);
+            mlfq_set_level(sim, task, 0);
+            mlfq_insert(sim, rq, task);
+        }
+        rq->ready &= ~(1ULL << level);
+    }
+}
+
+void mlfq_enqueue(SchedSim* sim, void* rq, int task) {
+    MlfqRunqueue* mlfq = (MlfqRunqueue*)rq;
+    mlfq_boost(sim, mlfq);
+    mlfq_set_level(sim, task, 0);
+    mlfq_insert(sim, mlfq, task);
+}
+
+// Charge the CPU time used since the task was picked to its level; once
+// the level's allotment is spent it drops a level (whether it used it in
+// one slice or several), so yielding just before expiry gains nothing
+void mlfq_requeue(SchedSim* sim, void* rq, int task, int reason) {
+    (void)reason;
+    MlfqRunqueue* mlfq = (MlfqRunqueue*)rq;
+    LinuxProcess* p = &sim->procs[task];
+    mlfq_boost(sim, mlfq);
+
+    sim_time_t exec = p->burst_time - p->remaining_time;
+    p->level_used += exec - p->level_exec;
+    p->level_exec = exec;
+    if (p->level_epoch != mlfq->epoch) {
+        mlfq_set_level(sim, task, 0);
+    } else {
+        // The bottom level is plain round robin: a fresh allotment each time
+        sim_time_t allotment = mlfq_config.quantum[p->level];
+        if (allotment > 0 && p->level_used >= allotment) {
+            int bottom = mlfq_config.levels - 1;
+            mlfq_set_level(sim, task, p->level < bottom ? p->level + 1 : bottom);
+        }
+    }
+    mlfq_insert(sim, mlfq, task);
+}
+
+int mlfq_select_next(SchedSim* sim, void* rq) {
+    MlfqRunqueue* mlfq = (MlfqRunqueue*)rq;
+    mlfq_boost(sim, mlfq);
+    if (mlfq->ready == 0) return -1;
+
+    int level = __builtin_ctzll(mlfq->ready);
+    int task = dequeue(mlfq->level[level]);
+    if (is_queue_empty(mlfq->level[level])) {
+        mlfq->ready &= ~(1ULL << level);
+    }
+    LinuxProcess* p = &sim->procs[task];
+    if (p->level_epoch != mlfq->epoch) {
+        mlfq_set_level(sim, task, 0); // boosted while waiting at level 0
+    }
+    p->level_exec = p->burst_time - p->remaining_time;
+    return task;
+}
+
+void mlfq_complete(SchedSim* sim, void* rq, int task) {
+    const LinuxProcess* p = &sim->procs[task];
+    ((MlfqRunqueue*)rq)->done[p->level][p->task_class]++;
+}
+
+// A task ready at a higher level takes the CPU from a lower-level one
+int mlfq_check_preempt(SchedSim* sim, void* rq, int running) {
+    MlfqRunqueue* mlfq = (MlfqRunqueue*)rq;
+    mlfq_boost(sim, mlfq);
+    if (mlfq->ready == 0) return 0;
+    const LinuxProcess* p = &sim->procs[running];
+    int level = p->level_epoch == mlfq->epoch ? p->level : 0;
+    return __builtin_ctzll(mlfq->ready) < level;
+}
+
+// Whatever is left of the level's allotment
+sim_time_t mlfq_time_slice(SchedSim* sim, void* rq, int task) {
+    (void)rq;
+    const LinuxProcess* p = &sim->procs[task];
+    sim_time_t allotment = mlfq_config.quantum[p->level];
+    if (allotment == 0) return 0;
+    return allotment > p->level_used ? allotment - p->level_used : 1;
+}
+
+const SchedPolicy MLFQ_POLICY = {
+    "MLFQ", 0,
+    mlfq_create, mlfq_destroy,
+    mlfq_enqueue, mlfq_select_next, mlfq_check_preempt, mlfq_requeue, mlfq_complete,
+    mlfq_time_slice, NULL
+};
+
+// ---------------------------------------------------------------------------
+// Stride / lottery: proportional share between the POS and LPUS classes.
+// Each class holds tickets. The CPU goes to the ready class with the lowest
+// pass (stride) or to the holder of a randomly drawn ticket (lottery); the
+// class pass then grows by the CPU time used times STRIDE1 / tickets. Within
+// a class, tasks sit in a heap keyed on their own pass, so the least served
+// one runs next: O(log n) per decision.
+// ---------------------------------------------------------------------------
+
+#define STRIDE1 1024
+#define STRIDE_SHARE_BUCKETS 10       // the window slides one bucket at a time
+#define STRIDE_SHARE_TOLERANCE 0.05   // "on target": within 5 points of the configured share
+
+typedef struct {
+    int tickets[TASK_CLASS_COUNT];
+    uint64_t seed;        // lottery draws (each CPU gets its own stream)
+    sim_time_t window;    // sliding window of the achieved-share report
+} StrideConfig;
+
+// Defaults: LPUS is guaranteed 20% of each CPU whenever it has work
+StrideConfig stride_config = { {80, 20}, 1, MS_TO_NS(1000) };
+
+// Achieved share per class over a sliding window, updated as CPU time is
+// charged. The window is a ring of buckets; when a bucket closes, the window
+// ending with it is folded into running statistics, so memory is constant
+// however long the run. Only windows in which both classes had ready work at
+// every scheduling decision count: the others say nothing about the guarantee.
+typedef struct {
+    sim_time_t used[STRIDE_SHARE_BUCKETS][TASK_CLASS_COUNT];
+    int idle[STRIDE_SHARE_BUCKETS];  // bit c set: class c had nothing ready at a decision
+    long long bucket;                // bucket being filled (time / bucket width)
+    sim_time_t total[TASK_CLASS_COUNT];
+
+    long long windows;               // contended windows evaluated
+    double share_sum[TASK_CLASS_COUNT];
+    double share_min[TASK_CLASS_COUNT];
+    double share_max[TASK_CLASS_COUNT];
+    long long on_target[TASK_CLASS_COUNT];
+} StrideShare;
+
+typedef struct {
+    TaskHeap queue[TASK_CLASS_COUNT];
+    sim_time_t class_pass[TASK_CLASS_COUNT];
+    sim_time_t pass_floor;                   // pass of the class picked last
+    sim_time_t task_floor[TASK_CLASS_COUNT]; // pass of the task picked last, per class
+    Rng rng;
+    StrideShare share;
+} StrideRunqueue;
+
+double stride_configured_share(int task_class) {
+    int total = 0;
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        total += stride_config.tickets[c];
+    }
+    return (double)stride_config.tickets[task_class] / total;
+}
+
+sim_time_t stride_bucket_width(void) {
+    sim_time_t width = stride_config.window / STRIDE_SHARE_BUCKETS;
+    return width > 0 ? width : 1;
+}
+
+// Close the bucket being filled and evaluate the window that ends with it
+void stride_share_close(StrideShare* s) {
+    if (s->bucket >= STRIDE_SHARE_BUCKETS - 1) {
+        sim_time_t used[TASK_CLASS_COUNT] = {0};
+        sim_time_t busy = 0;
+        int idle = 0;
+        for (int b = 0; b < STRIDE_SHARE_BUCKETS; b++) {
+            for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+                used[c] += s->used[b][c];
+                busy += s->used[b][c];
+            }
+            idle |= s->idle[b];
+        }
+        if (idle == 0 && busy > 0) {
+            for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+                double share = (double)used[c] / busy;
+                if (s->windows == 0 || share < s->share_min[c]) s->share_min[c] = share;
+                if (s->windows == 0 || share > s->share_max[c]) s->share_max[c] = share;
+                s->share_sum[c] += share;
+                if (fabs(share - stride_configured_share(c)) <= STRIDE_SHARE_TOLERANCE) {
+                    s->on_target[c]++;
+                }
+            }
+            s->windows++;
+        }
+    }
+    s->bucket++;
+    int slot = (int)(s->bucket % STRIDE_SHARE_BUCKETS);
+    memset(s->used[slot], 0, sizeof(s->used[slot]));
+    s->idle[slot] = 0;
+}
+
+// Move the current bucket up to the one holding time t. After a full turn
+// of the ring the remaining windows are empty, so a long gap is skipped.
+void stride_share_advance(StrideShare* s, sim_time_t t) {
+    long long target = t / stride_bucket_width();
+    for (int step = 0; s->bucket < target && step < STRIDE_SHARE_BUCKETS; step++) {
+        stride_share_close(s);
+    }
+    if (s->bucket < target) {
+        s->bucket = target;
+    }
+}
+
+// Charge [start, end) of CPU time to a class, split at bucket boundaries
+void stride_share_charge(StrideShare* s, int task_class, sim_time_t start, sim_time_t end) {
+    sim_time_t width = stride_bucket_width();
+    while (start < end) {
+        stride_share_advance(s, start);
+        sim_time_t bucket_end = (s->bucket + 1) * width;
+        sim_time_t stop = end < bucket_end ? end : bucket_end;
+        s->used[s->bucket % STRIDE_SHARE_BUCKETS][task_class] += stop - start;
+        s->total[task_class] += stop - start;
+        start = stop;
+    }
+}
+
+int stride_before(const LinuxProcess* a, const LinuxProcess* b) {
+    if (a->pass != b->pass) return a->pass < b->pass;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time;
+    return a->seq < b->seq;
+}
+
+void* stride_create(SchedSim* sim) {
+    StrideRunqueue* rq = (StrideRunqueue*)calloc(1, sizeof(StrideRunqueue));
+    if (rq == NULL) {
+        perror("stride_create: calloc failed");
+        exit(1);
+    }
+    // CPUs are created in order, so the queues made so far give this one's index
+    int cpu = 0;
+    while (cpu < sim->ncpus && sim->cpus[cpu].rq != NULL) cpu++;
+    rng_seed(&rq->rng, stride_config.seed + cpu);
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        heap_init(&rq->queue[c], sim, stride_before, sim->count);
+    }
+    return rq;
+}
+
+void stride_destroy(void* rq) {
+    StrideRunqueue* stride = (StrideRunqueue*)rq;
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        heap_free(&stride->queue[c]);
+    }
+    free(stride);
+}
+
+// A class that had no work rejoins at the current pass floor, so it cannot
+// claim CPU time for the period it was idle
+void stride_insert(SchedSim* sim, StrideRunqueue* rq, int task) {
+    int task_class = sim->procs[task].task_class;
+    int curr = sim_rq_current(sim, rq);
+    if (rq->queue[task_class].count == 0 && (curr == -1 || sim->procs[curr].task_class != task_class)) {
+        if (rq->class_pass[task_class] < rq->pass_floor) {
+            rq->class_pass[task_class] = rq->pass_floor;
+        }
+    }
+    heap_push(&rq->queue[task_class], task);
+}
+
+void stride_enqueue(SchedSim* sim, void* rq, int task) {
+    StrideRunqueue* stride = (StrideRunqueue*)rq;
+    LinuxProcess* p = &sim->procs[task];
+    p->pass = stride->task_floor[p->task_class];
+    p->pass_exec = 0;
+    stride_insert(sim, stride, task);
+}
+
+// Charge the CPU time the task used since it was picked to it and its class
+void stride_charge(SchedSim* sim, StrideRunqueue* rq, int task) {
+    LinuxProcess* p = &sim->procs[task];
+    sim_time_t exec = p->burst_time - p->remaining_time;
+    sim_time_t delta = exec - p->pass_exec;
+    if (delta <= 0) return;
+    sim_time_t charge = delta * STRIDE1 / stride_config.tickets[p->task_class];
+    p->pass += charge;
+    p->pass_exec = exec;
+    rq->class_pass[p->task_class] += charge;
+    stride_share_charge(&rq->share, p->task_class, sim->current_time - delta, sim->current_time);
+}
+
+void stride_requeue(SchedSim* sim, void* rq, int task, int reason) {
+    StrideRunqueue* stride = (StrideRunqueue*)rq;
+    LinuxProcess* p = &sim->procs[task];
+    if (reason == SCHED_REQUEUE_MIGRATE) {
+        // Keep its lead or lag within the class, not the absolute pass
+        p->pass += stride->task_floor[p->task_class] - p->pass_base;
+    } else {
+        stride_charge(sim, stride, task);
+    }
+    stride_insert(sim, stride, task);
+}
+
+void stride_complete(SchedSim* sim, void* rq, int task) {
+    stride_charge(sim, (StrideRunqueue*)rq, task);
+}
+
+// Class that gets the CPU next, -1 if nothing is ready
+int stride_pick_class(StrideRunqueue* rq, int lottery) {
+    int best = -1;
+    if (lottery) {
+        int total = 0;
+        for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+            if (rq->queue[c].count > 0) total += stride_config.tickets[c];
+        }
+        if (total == 0) return -1;
+        int ticket = (int)(rng_next(&rq->rng) % (uint64_t)total);
+        for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+            if (rq->queue[c].count == 0) continue;
+            best = c;
+            ticket -= stride_config.tickets[c];
+            if (ticket < 0) break;
+        }
+        return best;
+    }
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        if (rq->queue[c].count == 0) continue;
+        if (best == -1 || rq->class_pass[c] < rq->class_pass[best]) best = c;
+    }
+    return best;
+}
+
+int stride_select(SchedSim* sim, StrideRunqueue* stride, int lottery) {
+    int curr = sim_rq_current(sim, stride);
+    stride_share_advance(&stride->share, sim->current_time);
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        if (stride->queue[c].count == 0 && (curr == -1 || sim->procs[curr].task_class != c)) {
+            stride->share.idle[stride->share.bucket % STRIDE_SHARE_BUCKETS] |= 1 << c;
+        }
+    }
+
+    int task_class = stride_pick_class(stride, lottery);
+    if (task_class == -1) return -1;
+    int task = heap_pop(&stride->queue[task_class]);
+    LinuxProcess* p = &sim->procs[task];
+    if (stride->class_pass[task_class] > stride->pass_floor) {
+        stride->pass_floor = stride->class_pass[task_class];
+    }
+    if (p->pass > stride->task_floor[task_class]) {
+        stride->task_floor[task_class] = p->pass;
+    }
+    p->pass_base = stride->task_floor[task_class];
+    return task;
+}
+
+int stride_select_next(SchedSim* sim, void* rq) {
+    return stride_select(sim, (StrideRunqueue*)rq, 0);
+}
+
+int lottery_select_next(SchedSim* sim, void* rq) {
+    return stride_select(sim, (StrideRunqueue*)rq, 1);
+}
+
+const SchedPolicy STRIDE_POLICY = {
+    "Stride", MS_TO_NS(TIME_QUANTUM),
+    stride_create, stride_destroy,
+    stride_enqueue, stride_select_next, NULL, stride_requeue, stride_complete,
+    NULL, NULL
+};
+
+// Same queues and accounting, but the class is drawn by lottery: shares
+// hold on average rather than deterministically
+const SchedPolicy LOTTERY_POLICY = {
+    "Lottery", MS_TO_NS(TIME_QUANTUM),
+    stride_create, stride_destroy,
+    stride_enqueue, lottery_select_next, NULL, stride_requeue, stride_complete,
+    NULL, NULL
+};
+
+#endif // PRIMECART_POLICIES_H
@@ -0,0 +1,401 @@
+// primecart_probe.h
+// Measures the host instead of assuming it: context-switch latency from
+// thread and process ping-pong, and cyclictest-style wake-up latency.
+//
+// Context switch: two parties hand a token back and forth, each blocking until it is their
+// turn, so every handoff is a sleep, a wake-up and a switch. Pinned to one
+// CPU the handoff is exactly one context switch; unpinned, the scheduler may
+// place the pair on different CPUs and the handoff becomes a cross-CPU
+// wake-up. Every round trip is timed and half of it recorded, so the
+// histograms show the tail, not just an average.
+//
+// Wake-up latency: one thread per CPU sleeps until absolute deadlines a
+// fixed interval apart (clock_nanosleep or a timerfd) and records how late
+// it actually ran. Optional batch threads keep every CPU busy meanwhile, the
+// way LPUS jobs do, so the figure is the one a POS task would see.
+//
+// Needs _GNU_SOURCE (CPU affinity) before the first system header.
+#ifndef PRIMECART_PROBE_H
+#define PRIMECART_PROBE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <sys/timerfd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "primecart_histogram.h"
+
+#define PROBE_WARMUP_ROUNDS 1000  // not recorded: caches, page faults, frequency ramp
+
+typedef struct {
+    const char* name;
+    int pin_cpu;              // CPU both parties run on, -1 = unpinned
+    Histogram handoff;        // one-way handoff latency, ns
+    int ok;                   // 0 if the probe could not run
+} SwitchProbe;
+
+long long probe_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Lowest CPU this process may run on, -1 if unknown
+int probe_first_cpu(void) {
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return -1;
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &set)) return c;
+    }
+    return -1;
+}
+
+// Pin the calling thread to cpu (threads and children created afterwards
+// inherit it); the previous mask goes to saved. Returns 0 on success.
+int probe_pin(int cpu, cpu_set_t* saved) {
+    if (sched_getaffinity(0, sizeof(*saved), saved) != 0) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set);
+}
+
+void probe_unpin(const cpu_set_t* saved) {
+    sched_setaffinity(0, sizeof(*saved), saved);
+}
+
+// ---------------------------------------------------------------------------
+// Thread switch: futex ping-pong
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int word;                 // 1 = partner's turn, 0 = timer's turn
+    int rounds;
+} FutexPair;
+
+void probe_futex_wait(int* word, int value) {
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+void probe_futex_wake(int* word) {
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+void* probe_futex_partner(void* arg) {
+    FutexPair* pair = (FutexPair*)arg;
+    for (int i = 0; i < pair->rounds; i++) {
+        while (__atomic_load_n(&pair->word, __ATOMIC_ACQUIRE) == 0) {
+            probe_futex_wait(&pair->word, 0);
+        }
+        __atomic_store_n(&pair->word, 0, __ATOMIC_RELEASE);
+        probe_futex_wake(&pair->word);
+    }
+    return NULL;
+}
+
+void probe_thread_switch(SwitchProbe* probe, int iterations) {
+    FutexPair pair = { 0, iterations + PROBE_WARMUP_ROUNDS };
+    pthread_t partner;
+    hist_init(&probe->handoff);
+    probe->ok = 0;
+    int rc = pthread_create(&partner, NULL, probe_futex_partner, &pair);
+    if (rc != 0) {
+        fprintf(stderr, "probe: pthread_create failed: %s\n", strerror(rc));
+        return;
+    }
+    for (int i = 0; i < pair.rounds; i++) {
+        long long started = probe_now_ns();
+        __atomic_store_n(&pair.word, 1, __ATOMIC_RELEASE);
+        probe_futex_wake(&pair.word);
+        while (__atomic_load_n(&pair.word, __ATOMIC_ACQUIRE) == 1) {
+            probe_futex_wait(&pair.word, 1);
+        }
+        if (i >= PROBE_WARMUP_ROUNDS) {
+            hist_record(&probe->handoff, (uint64_t)(probe_now_ns() - started) / 2);
+        }
+    }
+    pthread_join(partner, NULL);
+    probe->ok = 1;
+}
+
+// ---------------------------------------------------------------------------
+// Process switch: pipe ping-pong
+// ---------------------------------------------------------------------------
+
+void probe_process_switch(SwitchProbe* probe, int iterations) {
+    int to_child[2];
+    int to_parent[2];
+    hist_init(&probe->handoff);
+    probe->ok = 0;
+    if (pipe(to_child) != 0) {
+        perror("probe: pipe failed");
+        return;
+    }
+    if (pipe(to_parent) != 0) {
+        perror("probe: pipe failed");
+        close(to_child[0]);
+        close(to_child[1]);
+        return;
+    }
+    pid_t child = fork();
+    if (child < 0) {
+        perror("probe: fork failed");
+        close(to_child[0]);
+        close(to_child[1]);
+        close(to_parent[0]);
+        close(to_parent[1]);
+        return;
+    }
+    char token = 'x';
+    if (child == 0) {
+        close(to_child[1]);
+        close(to_parent[0]);
+        while (read(to_child[0], &token, 1) == 1) {
+            if (write(to_parent[1], &token, 1) != 1) break;
+        }
+        _exit(0);
+    }
+    close(to_child[0]);
+    close(to_parent[1]);
+
+    int rounds = iterations + PROBE_WARMUP_ROUNDS;
+    int completed = 1;
+    for (int i = 0; i < rounds; i++) {
+        long long started = probe_now_ns();
+        if (write(to_child[1], &token, 1) != 1 || read(to_parent[0], &token, 1) != 1) {
+            perror("probe: pipe ping-pong failed");
+            completed = 0;
+            break;
+        }
+        if (i >= PROBE_WARMUP_ROUNDS) {
+            hist_record(&probe->handoff, (uint64_t)(probe_now_ns() - started) / 2);
+        }
+    }
+    close(to_child[1]); // the child sees EOF and exits
+    close(to_parent[0]);
+    waitpid(child, NULL, 0);
+    probe->ok = completed;
+}
+
+// Run one ping-pong on pin_cpu (or unpinned if -1). If pinning is refused
+// the probe still runs, unpinned, and pin_cpu is reset to say so.
+void probe_context_switch(SwitchProbe* probe, int process, int iterations) {
+    cpu_set_t saved;
+    int pinned = probe->pin_cpu >= 0 && probe_pin(probe->pin_cpu, &saved) == 0;
+    if (probe->pin_cpu >= 0 && !pinned) {
+        perror("probe: cannot pin to one CPU, measuring unpinned");
+        probe->pin_cpu = -1;
+    }
+    if (process) {
+        probe_process_switch(probe, iterations);
+    } else {
+        probe_thread_switch(probe, iterations);
+    }
+    if (pinned) probe_unpin(&saved);
+}
+
+// ---------------------------------------------------------------------------
+// Wake-up latency and jitter
+// ---------------------------------------------------------------------------
+
+#define PROBE_MAX_CPUS        256
+#define PROBE_LOAD_BYTES      (256 * 1024) // per batch thread: larger than L1/L2
+
+typedef struct {
+    long long interval_ns;    // period between deadlines
+    long long loops;          // wake-ups per CPU
+    int use_timerfd;          // 0 = clock_nanosleep(TIMER_ABSTIME)
+    int fifo_priority;        // SCHED_FIFO priority for the timer threads, 0 = normal
+    int load_per_cpu;         // batch threads pinned to each CPU
+} JitterConfig;
+
+typedef struct {
+    const JitterConfig* config;
+    int cpu;
+    Histogram latency;        // ns past each deadline
+    int fifo;                 // 1 if SCHED_FIFO was granted
+    int ok;
+} JitterProbe;
+
+typedef struct {
+    int cpu;
+    int* stop;
+} LoadThread;
+
+// CPUs this process may run on, at most max of them; returns the count
+int probe_allowed_cpus(int* cpus, int max) {
+    cpu_set_t set;
+    int count = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return 0;
+    for (int c = 0; c < CPU_SETSIZE && count < max; c++) {
+        if (CPU_ISSET(c, &set)) cpus[count++] = c;
+    }
+    return count;
+}
+
+int probe_pin_thread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set);
+}
+
+// Synthetic LPUS batch work: read-modify-write sweeps over a buffer larger
+// than the private caches, until told to stop
+void* probe_load_thread(void* arg) {
+    LoadThread* load = (LoadThread*)arg;
+    probe_pin_thread(load->cpu);
+    unsigned* buffer = (unsigned*)calloc(PROBE_LOAD_BYTES / sizeof(unsigned), sizeof(unsigned));
+    if (buffer == NULL) return NULL;
+    size_t words = PROBE_LOAD_BYTES / sizeof(unsigned);
+    unsigned x = (unsigned)load->cpu + 1;
+    while (!__atomic_load_n(load->stop, __ATOMIC_RELAXED)) {
+        for (size_t i = 0; i < words; i += 16) {
+            x = x * 1664525u + 1013904223u;
+            buffer[i] += x;
+        }
+    }
+    free(buffer);
+    return NULL;
+}
+
+long long probe_timespec_ns(const struct timespec* ts) {
+    return (long long)ts->tv_sec * 1000000000LL + ts->tv_nsec;
+}
+
+struct timespec probe_ns_timespec(long long ns) {
+    struct timespec ts;
+    ts.tv_sec = ns / 1000000000LL;
+    ts.tv_nsec = ns % 1000000000LL;
+    return ts;
+}
+
+void* probe_jitter_thread(void* arg) {
+    JitterProbe* probe = (JitterProbe*)arg;
+    const JitterConfig* config = probe->config;
+    if (probe_pin_thread(probe->cpu) != 0) {
+        perror("probe: cannot pin timer thread");
+        return NULL;
+    }
+    if (config->fifo_priority > 0) {
+        struct sched_param param;
+        param.sched_priority = config->fifo_priority;
+        probe->fifo = sched_setscheduler(0, SCHED_FIFO, &param) == 0;
+    }
+
+    int fd = -1;
+    long long deadline = probe_now_ns() + config->interval_ns;
+    if (config->use_timerfd) {
+        fd = timerfd_create(CLOCK_MONOTONIC, 0);
+        struct itimerspec spec;
+        spec.it_value = probe_ns_timespec(deadline);
+        spec.it_interval = probe_ns_timespec(config->interval_ns);
+        if (fd < 0 || timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, NULL) != 0) {
+            perror("probe: timerfd failed");
+            if (fd >= 0) close(fd);
+            return NULL;
+        }
+    }
+    for (long long i = 0; i < config->loops; ) {
+        if (config->use_timerfd) {
+            uint64_t expirations;
+            if (read(fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations)) {
+                perror("probe: timerfd read failed");
+                close(fd);
+                return NULL;
+            }
+            // Missed periods still count: the latency is against the oldest one
+            long long now = probe_now_ns();
+            hist_record(&probe->latency, (uint64_t)(now - deadline));
+            deadline += (long long)expirations * config->interval_ns;
+            i += (long long)expirations;
+        } else {
+            struct timespec ts = probe_ns_timespec(deadline);
+            // The deadline is absolute: after EINTR just sleep again
+            int rc;
+            do {
+                rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+            } while (rc == EINTR);
+            if (rc != 0) {
+                fprintf(stderr, "probe: clock_nanosleep failed: %s\n", strerror(rc));
+                return NULL;
+            }
+            long long now = probe_now_ns();
+            hist_record(&probe->latency, (uint64_t)(now - deadline));
+            deadline += config->interval_ns;
+            i++;
+        }
+    }
+    if (fd >= 0) close(fd);
+    probe->ok = 1;
+    return NULL;
+}
+
+// One timer thread per CPU in cpus[], with the configured batch load on
+// every one of them; per-CPU histograms go to probes[], all of them merged
+// into total. Returns the number of CPUs that completed.
+int probe_wakeup_latency(const JitterConfig* config, const int* cpus, int ncpus,
+                         JitterProbe* probes, Histogram* total) {
+    int stop = 0;
+    int nload = ncpus * config->load_per_cpu;
+    LoadThread* loads = (LoadThread*)calloc(nload > 0 ? nload : 1, sizeof(LoadThread));
+    pthread_t* load_threads = (pthread_t*)calloc(nload > 0 ? nload : 1, sizeof(pthread_t));
+    pthread_t* timer_threads = (pthread_t*)calloc(ncpus, sizeof(pthread_t));
+    int* running = (int*)calloc(ncpus, sizeof(int));
+    if (loads == NULL || load_threads == NULL || timer_threads == NULL || running == NULL) {
+        perror("probe: calloc failed");
+        exit(1);
+    }
+
+    int loads_started = 0;
+    for (int i = 0; i < nload; i++) {
+        loads[i].cpu = cpus[i % ncpus];
+        loads[i].stop = &stop;
+        int rc = pthread_create(&load_threads[loads_started], NULL, probe_load_thread, &loads[i]);
+        if (rc != 0) {
+            fprintf(stderr, "probe: cannot start load thread: %s\n", strerror(rc));
+            break;
+        }
+        loads_started++;
+    }
+    for (int c = 0; c < ncpus; c++) {
+        probes[c].config = config;
+        probes[c].cpu = cpus[c];
+        probes[c].fifo = 0;
+        probes[c].ok = 0;
+        hist_init(&probes[c].latency);
+        int rc = pthread_create(&timer_threads[c], NULL, probe_jitter_thread, &probes[c]);
+        running[c] = rc == 0;
+        if (!running[c]) fprintf(stderr, "probe: cannot start timer thread: %s\n", strerror(rc));
+    }
+
+    int completed = 0;
+    hist_init(total);
+    for (int c = 0; c < ncpus; c++) {
+        if (!running[c]) continue;
+        pthread_join(timer_threads[c], NULL);
+        if (probes[c].ok) {
+            hist_merge(total, &probes[c].latency);
+            completed++;
+        }
+    }
+    __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < loads_started; i++) {
+        pthread_join(load_threads[i], NULL);
+    }
+    free(loads);
+    free(load_threads);
+    free(timer_threads);
+    free(running);
+    return completed;
+}
+
+#endif // PRIMECART_PROBE_H
@@ -0,0 +1,309 @@
+// primecart_rbtree.h
+// Red-black tree of process indices, used as an ordered ready queue (CFS).
+//
+// Like TaskHeap, the tree links live in arrays indexed by process index, so
+// insert and erase are O(log n) without per-node allocations, and the keys
+// are read live from sim->procs. The leftmost (smallest) task is cached, so
+// picking the next task is O(1).
+#ifndef PRIMECART_RBTREE_H
+#define PRIMECART_RBTREE_H
+
+#include "primecart_sched.h"
+
+#define RB_BLACK     0
+#define RB_RED       1
+#define RB_DETACHED -1 // not in the tree
+
+typedef struct {
+    SchedSim* sim;        // key fields are read live from sim->procs
+    TaskOrder before;
+    int* left;            // child/parent links by process index, -1 = none
+    int* right;
+    int* parent;
+    signed char* color;   // RB_*
+    int root;
+    int leftmost;         // smallest task, -1 if empty
+    int count;
+    int capacity;         // number of process indices the arrays can hold (grows)
+} RbTree;
+
+void rbtree_init(RbTree* t, SchedSim* sim, TaskOrder before) {
+    memset(t, 0, sizeof(*t));
+    t->sim = sim;
+    t->before = before;
+    t->root = -1;
+    t->leftmost = -1;
+}
+
+void rbtree_free(RbTree* t) {
+    free(t->left);
+    free(t->right);
+    free(t->parent);
+    free(t->color);
+    rbtree_init(t, t->sim, t->before);
+}
+
+// Grow the link arrays to cover process indices below capacity
+void rbtree_reserve(RbTree* t, int capacity) {
+    if (capacity <= t->capacity) return;
+    int grown_capacity = t->capacity * 2 > capacity ? t->capacity * 2 : capacity;
+    if (grown_capacity < 64) grown_capacity = 64;
+    int* left = (int*)realloc(t->left, sizeof(int) * grown_capacity);
+    if (left != NULL) t->left = left;
+    int* right = (int*)realloc(t->right, sizeof(int) * grown_capacity);
+    if (right != NULL) t->right = right;
+    int* parent = (int*)realloc(t->parent, sizeof(int) * grown_capacity);
+    if (parent != NULL) t->parent = parent;
+    signed char* color = (signed char*)realloc(t->color, grown_capacity);
+    if (color != NULL) t->color = color;
+    if (left == NULL || right == NULL || parent == NULL || color == NULL) {
+        perror("rbtree_reserve: realloc failed");
+        exit(1);
+    }
+    memset(t->color + t->capacity, RB_DETACHED, grown_capacity - t->capacity);
+    t->capacity = grown_capacity;
+}
+
+int rbtree_less(const RbTree* t, int a, int b) {
+    const LinuxProcess* procs = t->sim->procs;
+    return t->before(&procs[a], &procs[b]);
+}
+
+int rbtree_is_red(const RbTree* t, int node) {
+    return node != -1 && t->color[node] == RB_RED;
+}
+
+// Smallest task without removing it, -1 if empty
+int rbtree_first(const RbTree* t) {
+    return t->leftmost;
+}
+
+// In-order successor of a queued task, -1 if it is the largest
+int rbtree_next(const RbTree* t, int node) {
+    if (t->right[node] != -1) {
+        node = t->right[node];
+        while (t->left[node] != -1) node = t->left[node];
+        return node;
+    }
+    int parent = t->parent[node];
+    while (parent != -1 && node == t->right[parent]) {
+        node = parent;
+        parent = t->parent[node];
+    }
+    return parent;
+}
+
+// Put v where u hangs in the tree (u's own links are left alone)
+void rbtree_replace_child(RbTree* t, int u, int v) {
+    int parent = t->parent[u];
+    if (parent == -1) {
+        t->root = v;
+    } else if (t->left[parent] == u) {
+        t->left[parent] = v;
+    } else {
+        t->right[parent] = v;
+    }
+    if (v != -1) t->parent[v] = parent;
+}
+
+void rbtree_rotate_left(RbTree* t, int x) {
+    int y = t->right[x];
+    t->right[x] = t->left[y];
+    if (t->left[y] != -1) t->parent[t->left[y]] = x;
+    rbtree_replace_child(t, x, y);
+    t->left[y] = x;
+    t->parent[x] = y;
+}
+
+void rbtree_rotate_right(RbTree* t, int x) {
+    int y = t->left[x];
+    t->left[x] = t->right[y];
+    if (t->right[y] != -1) t->parent[t->right[y]] = x;
+    rbtree_replace_child(t, x, y);
+    t->right[y] = x;
+    t->parent[x] = y;
+}
+
+void rbtree_insert(RbTree* t, int task) {
+    rbtree_reserve(t, task + 1);
+
+    int parent = -1;
+    int node = t->root;
+    int go_left = 0;
+    int leftmost = 1;
+    while (node != -1) {
+        parent = node;
+        go_left = rbtree_less(t, task, node);
+        if (go_left) {
+            node = t->left[node];
+        } else {
+            node = t->right[node];
+            leftmost = 0;
+        }
+    }
+    t->parent[task] = parent;
+    t->left[task] = -1;
+    t->right[task] = -1;
+    t->color[task] = RB_RED;
+    if (parent == -1) {
+        t->root = task;
+    } else if (go_left) {
+        t->left[parent] = task;
+    } else {
+        t->right[parent] = task;
+    }
+    if (leftmost) t->leftmost = task;
+    t->count++;
+
+    // Restore the red-black properties: no red node has a red parent
+    int z = task;
+    while (rbtree_is_red(t, t->parent[z])) {
+        int p = t->parent[z];
+        int g = t->parent[p]; // exists: a red node is never the root
+        if (p == t->left[g]) {
+            int uncle = t->right[g];
+            if (rbtree_is_red(t, uncle)) {
+                t->color[p] = RB_BLACK;
+                t->color[uncle] = RB_BLACK;
+                t->color[g] = RB_RED;
+                z = g;
+                continue;
+            }
+            if (z == t->right[p]) {
+                z = p;
+                rbtree_rotate_left(t, z);
+                p = t->parent[z];
+            }
+            t->color[p] = RB_BLACK;
+            t->color[g] = RB_RED;
+            rbtree_rotate_right(t, g);
+        } else {
+            int uncle = t->left[g];
+            if (rbtree_is_red(t, uncle)) {
+                t->color[p] = RB_BLACK;
+                t->color[uncle] = RB_BLACK;
+                t->color[g] = RB_RED;
+                z = g;
+                continue;
+            }
+            if (z == t->left[p]) {
+                z = p;
+                rbtree_rotate_right(t, z);
+                p = t->parent[z];
+            }
+            t->color[p] = RB_BLACK;
+            t->color[g] = RB_RED;
+            rbtree_rotate_left(t, g);
+        }
+    }
+    t->color[t->root] = RB_BLACK;
+}
+
+// Rebalance after a black node was unlinked; x (possibly -1) took its place
+// under x_parent and is one black node short
+void rbtree_erase_fixup(RbTree* t, int x, int x_parent) {
+    while (x != t->root && !rbtree_is_red(t, x)) {
+        if (x == t->left[x_parent]) {
+            int w = t->right[x_parent];
+            if (rbtree_is_red(t, w)) {
+                t->color[w] = RB_BLACK;
+                t->color[x_parent] = RB_RED;
+                rbtree_rotate_left(t, x_parent);
+                w = t->right[x_parent];
+            }
+            if (!rbtree_is_red(t, t->left[w]) && !rbtree_is_red(t, t->right[w])) {
+                t->color[w] = RB_RED;
+                x = x_parent;
+                x_parent = t->parent[x];
+                continue;
+            }
+            if (!rbtree_is_red(t, t->right[w])) {
+                t->color[t->left[w]] = RB_BLACK;
+                t->color[w] = RB_RED;
+                rbtree_rotate_right(t, w);
+                w = t->right[x_parent];
+            }
+            t->color[w] = t->color[x_parent];
+            t->color[x_parent] = RB_BLACK;
+            t->color[t->right[w]] = RB_BLACK;
+            rbtree_rotate_left(t, x_parent);
+        } else {
+            int w = t->left[x_parent];
+            if (rbtree_is_red(t, w)) {
+                t->color[w] = RB_BLACK;
+                t->color[x_parent] = RB_RED;
+                rbtree_rotate_right(t, x_parent);
+                w = t->left[x_parent];
+            }
+            if (!rbtree_is_red(t, t->left[w]) && !rbtree_is_red(t, t->right[w])) {
+                t->color[w] = RB_RED;
+                x = x_parent;
+                x_parent = t->parent[x];
+                continue;
+            }
+            if (!rbtree_is_red(t, t->left[w])) {
+                t->color[t->right[w]] = RB_BLACK;
+                t->color[w] = RB_RED;
+                rbtree_rotate_left(t, w);
+                w = t->left[x_parent];
+            }
+            t->color[w] = t->color[x_parent];
+            t->color[x_parent] = RB_BLACK;
+            t->color[t->left[w]] = RB_BLACK;
+            rbtree_rotate_right(t, x_parent);
+        }
+        x = t->root;
+    }
+    if (x != -1) t->color[x] = RB_BLACK;
+}
+
+// Remove a queued task from anywhere in the tree
+void rbtree_erase(RbTree* t, int z) {
+    if (t->leftmost == z) {
+        t->leftmost = rbtree_next(t, z);
+    }
+
+    int removed_color = t->color[z];
+    int x;
+    int x_parent;
+    if (t->left[z] == -1 || t->right[z] == -1) {
+        x = t->left[z] != -1 ? t->left[z] : t->right[z];
+        x_parent = t->parent[z];
+        rbtree_replace_child(t, z, x);
+    } else {
+        // Two children: the successor y takes z's place and colour
+        int y = t->right[z];
+        while (t->left[y] != -1) y = t->left[y];
+        removed_color = t->color[y];
+        x = t->right[y];
+        if (t->parent[y] == z) {
+            x_parent = y;
+        } else {
+            x_parent = t->parent[y];
+            rbtree_replace_child(t, y, x);
+            t->right[y] = t->right[z];
+            t->parent[t->right[y]] = y;
+        }
+        rbtree_replace_child(t, z, y);
+        t->left[y] = t->left[z];
+        t->parent[t->left[y]] = y;
+        t->color[y] = t->color[z];
+    }
+    t->color[z] = RB_DETACHED;
+    t->count--;
+
+    if (removed_color == RB_BLACK) {
+        rbtree_erase_fixup(t, x, x_parent);
+    }
+}
+
+// Remove and return the smallest task, -1 if empty
+int rbtree_pop_first(RbTree* t) {
+    int task = t->leftmost;
+    if (task != -1) {
+        rbtree_erase(t, task);
+    }
+    return task;
+}
+
+#endif // PRIMECART_RBTREE_H
@@ -0,0 +1,91 @@
+// primecart_rng.h
+// Seeded pseudo-random numbers for workload generation.
+//
+// xoshiro256** seeded through splitmix64: fast, 2^256 period, and the same
+// seed always yields the same stream on every platform, so generated traces
+// are reproducible from their command line alone.
+#ifndef PRIMECART_RNG_H
+#define PRIMECART_RNG_H
+
+#include <stdint.h>
+#include <math.h>
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+uint64_t rng_splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng* rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = rng_splitmix64(&seed);
+    }
+}
+
+// Counter-based draw: value number counter of the stream keyed by key,
+// computed directly from the pair with no state to share or advance
+uint64_t rng_counter(uint64_t key, uint64_t counter) {
+    uint64_t x = rng_splitmix64(&key) ^ counter;
+    return rng_splitmix64(&x);
+}
+
+// Independent stream number stream of a seed. The state is a pure function
+// of (seed, stream), so parallel workers derive their own streams without
+// touching a common generator, and any one stream can be replayed alone.
+void rng_seed_stream(Rng* rng, uint64_t seed, uint64_t stream) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = rng_counter(seed, stream * 4 + i);
+    }
+}
+
+uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+uint64_t rng_next(Rng* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Uniform in (0, 1): never 0, so log() of it is always finite
+double rng_uniform(Rng* rng) {
+    return ((rng_next(rng) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+double rng_exponential(Rng* rng, double mean) {
+    return -mean * log(rng_uniform(rng));
+}
+
+// Standard normal (Box-Muller, one value per call)
+double rng_normal(Rng* rng) {
+    double u1 = rng_uniform(rng);
+    double u2 = rng_uniform(rng);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Lognormal with the given mean; sigma is the shape of the underlying normal
+double rng_lognormal(Rng* rng, double mean, double sigma) {
+    double mu = log(mean) - 0.5 * sigma * sigma;
+    return exp(mu + sigma * rng_normal(rng));
+}
+
+// Pareto (type I) with the given mean; needs alpha > 1 for a finite mean
+double rng_pareto(Rng* rng, double mean, double alpha) {
+    double scale = mean * (alpha - 1.0) / alpha;
+    return scale / pow(rng_uniform(rng), 1.0 / alpha);
+}
+
+#endif // PRIMECART_RNG_H
@@ -0,0 +1,1362 @@
+// primecart_sched.h
+// Shared simulation core for the PrimeCart Linux schedulers.
+//
+// One process table, one event loop and one set of metrics for one or more
+// simulated CPUs (sim_set_cpus), each with its own ready queue. Scheduling
+// policies (FCFS, SJF, RR, preemptive priority, ...) plug in through
+// SchedPolicy; each *_linux.c program only keeps its own timeline messages,
+// Gantt rendering and algorithm notes. Tasks come from a Workload
+// (primecart_workload.h) or a record-by-record SimSource and enter the
+// process table as they arrive. Every reported metric is accumulated at
+// completion, so with sim_enable_streaming a finished task's slot is simply
+// reused and memory stays bounded by the tasks in the system at once, not
+// by the length of the arrival stream.
+//
+// Every simulator is a single-file program, so this header carries the
+// definitions too: include it from exactly one translation unit.
+#ifndef PRIMECART_SCHED_H
+#define PRIMECART_SCHED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "primecart_workload.h"
+#include "primecart_gantt.h"
+#include "primecart_host.h"
+#include "primecart_histogram.h"
+
+#define MIGRATION_COST_LINUX 0.020    // 20 μs in ms: cold caches after a CPU move
+
+// Simulated time is a 64-bit count of nanoseconds. Sub-millisecond costs
+// such as the 4 μs context switch accumulate exactly over long runs instead
+// of truncating to zero (int ms) or drifting (float ms).
+typedef long long sim_time_t; // ns
+
+#define NS_PER_US 1000LL
+#define NS_PER_MS 1000000LL
+#define MS_TO_NS(ms) ((sim_time_t)((ms) * NS_PER_MS))
+
+#define MIGRATION_COST_LINUX_NS MS_TO_NS(MIGRATION_COST_LINUX)
+
+// Simulated time in milliseconds, for reports
+double sim_ms(sim_time_t t) {
+    return t / (double)NS_PER_MS;
+}
+
+// Whole milliseconds, for the character-scaled Gantt charts
+int sim_whole_ms(sim_time_t t) {
+    return (int)(t / NS_PER_MS);
+}
+
+typedef struct {
+    char pid[12];
+    unsigned int id;            // numeric workload pid
+    const char* description;
+    const char* process_type;   // "Foreground" (POS) or "Background" (LPUS)
+    int kind;                   // TASK_KIND_*
+    int task_class;             // TASK_CLASS_*
+    sim_time_t arrival_time;    // ns
+    sim_time_t burst_time;      // ns
+    int priority;               // 1=highest, 5=lowest (lower number = higher priority)
+    sim_time_t remaining_time;  // ns left to run
+    sim_time_t ready_since;     // when it last entered a ready queue
+    sim_time_t start_time;      // ns, -1 until first dispatch
+    sim_time_t exit_time;       // ns
+    sim_time_t waiting_time;    // ns
+    sim_time_t turnaround_time; // ns
+    sim_time_t response_time;   // ns, -1 until first dispatch
+    sim_time_t deadline;        // absolute SLA completion deadline, ns
+    sim_time_t predicted_burst; // burst_time, or its estimate at arrival when predicting
+    int completed;       // 0 = not completed, 1 = completed
+    int preemptions;     // times the task lost the CPU before finishing
+    int last_cpu;        // CPU it last ran on, -1 before the first dispatch
+    int migrations;      // times it was dispatched on a different CPU
+    long long seq;       // admission order; breaks ties between equal keys
+
+    // CFS scheduling entity (CFS_POLICY)
+    int weight;                 // load weight, from priority via nice
+    sim_time_t vruntime;        // CPU time scaled by NICE_0_LOAD / weight
+    sim_time_t vruntime_exec;   // CPU time already folded into vruntime
+    sim_time_t vruntime_base;   // min_vruntime of the rq it was last picked from
+
+    // MLFQ queue state (MLFQ_POLICY)
+    int level;                  // 0 = top queue
+    long long level_epoch;      // boost period in which level was assigned
+    sim_time_t level_used;      // CPU time used at this level
+    sim_time_t level_exec;      // CPU time when it was last picked
+
+    // Priority aging state (PRIORITY_POLICY)
+    int aged_priority;          // level aging had reached when it last left a ready queue
+
+    // Stride scheduling state (STRIDE_POLICY, LOTTERY_POLICY)
+    sim_time_t pass;            // CPU time within its class, scaled by the class stride
+    sim_time_t pass_exec;       // CPU time already charged to pass
+    sim_time_t pass_base;       // class pass floor of the rq it was last picked from
+} LinuxProcess;
+
+// Strict ordering between two processes: nonzero if a must run before b.
+// Ties go to the earlier arrival (seq): indices are reused when streaming.
+typedef int (*TaskOrder)(const LinuxProcess* a, const LinuxProcess* b);
+
+// Why a running task was taken off the CPU before it finished
+#define SCHED_PREEMPT_QUANTUM  0 // time slice used up
+#define SCHED_PREEMPT_PRIORITY 1 // a better task became ready
+#define SCHED_REQUEUE_MIGRATE  2 // on_preempt only: queued task moved by the balancer
+
+typedef struct SchedSim SchedSim;
+
+// Scheduling policy plugin. The engine owns time, the process table and the
+// metrics; the policy owns the ready queues ("rq", one per CPU) and decides
+// who runs next.
+typedef struct {
+    const char* name;
+    sim_time_t quantum; // 0 = no time slicing
+
+    void* (*create)(SchedSim* sim);
+    void (*destroy)(void* rq);
+
+    // Task became ready for the first time
+    void (*on_arrival)(SchedSim* sim, void* rq, int task);
+    // Remove and return the task to run next, -1 if the ready queue is empty
+    int (*select_next)(SchedSim* sim, void* rq);
+    // Called when new tasks became ready while another one is running;
+    // nonzero preempts it. NULL means the policy only gives up the CPU on
+    // completion or quantum expiry, so arrivals never interrupt a slice.
+    int (*check_preempt)(SchedSim* sim, void* rq, int running);
+    // Running task was descheduled before completion and is ready again
+    // (also used to hand a queued task to another CPU's rq on rebalancing)
+    void (*on_preempt)(SchedSim* sim, void* rq, int task, int reason);
+    // Task finished its burst (optional)
+    void (*on_complete)(SchedSim* sim, void* rq, int task);
+    // Time slice for a task about to run from rq (optional); NULL means
+    // every dispatch gets the fixed quantum
+    sim_time_t (*time_slice)(SchedSim* sim, void* rq, int task);
+    // Time at which check_preempt would turn nonzero for the running task
+    // with no further arrivals, e.g. once a waiter has aged past it
+    // (optional); -1 means never. The CPU wakes up then to recheck. The
+    // running task's remaining_time is exact as of sim->current_time.
+    sim_time_t (*preempt_time)(SchedSim* sim, void* rq, int running);
+} SchedPolicy;
+
+// Schedule events streamed to an exporter as they happen (primecart_export.h)
+#define SIM_TRACE_SLICE   0 // task ran on the CPU for [start, end)
+#define SIM_TRACE_SWITCH  1 // context switch into task
+#define SIM_TRACE_IDLE    2 // CPU idle, nothing ready (task = -1)
+#define SIM_TRACE_PREEMPT 3 // instant: task lost the CPU, reason = SCHED_PREEMPT_*
+
+typedef struct {
+    int type;          // SIM_TRACE_*
+    int cpu;
+    int task;          // process index, -1 if none
+    sim_time_t start;
+    sim_time_t end;    // == start for instants
+    int reason;
+} SimTraceEvent;
+
+typedef struct {
+    void* ctx;
+    void (*emit)(void* ctx, const SchedSim* sim, const SimTraceEvent* event);
+    void (*close)(void* ctx); // called from sim_free
+} SimTracer;
+
+// Optional callbacks used by the programs to print their execution timeline
+typedef struct {
+    void (*on_dispatch)(SchedSim* sim, int task, int first_run);
+    void (*on_preempt)(SchedSim* sim, int task, int next, int reason);
+    void (*on_complete)(SchedSim* sim, int task);
+} SchedHooks;
+
+// One simulated CPU. Every CPU has its own ready queue created by the policy;
+// the policy's select_next / check_preempt logic runs unchanged per queue.
+typedef struct {
+    void* rq;
+    int nr_queued;            // tasks waiting in rq
+    int running;              // task owning the CPU (running or being switched in), -1 if idle
+    int switching;            // running task is still being switched in
+    int last_task;            // last process that held this CPU, -1 before the first,
+                              // SIM_TASK_RELEASED once its slot was freed
+    int recheck;              // tasks queued here while busy: check for preemption
+    sim_time_t event_time;    // switch done, completion, quantum expiry or preempt_time
+    sim_time_t run_start;     // start of the running task's current stretch
+    sim_time_t accounted;     // remaining_time/slice_used are exact up to here
+    sim_time_t slice_used;    // time the running task has had since dispatch
+    sim_time_t quantum;       // slice granted at dispatch, 0 = run to completion
+    sim_time_t idle_since;    // -1 while busy
+
+    sim_time_t busy_time;
+    sim_time_t idle_time;
+    sim_time_t switch_time;
+    int context_switches;
+    int migrations;           // tasks that moved here from another CPU
+} SimCpu;
+
+// How work moves between per-CPU ready queues (SMP only)
+#define SIM_BALANCE_NONE     0 // tasks stay where they were placed
+#define SIM_BALANCE_STEAL    1 // an idle CPU pulls from the longest queue
+#define SIM_BALANCE_PERIODIC 2 // every balance_period, even out queue lengths
+
+const char* sim_balance_names[] = {"none", "steal", "periodic"};
+
+// Per-task latencies kept as histograms (SimLatency)
+#define SIM_METRIC_WAIT       0
+#define SIM_METRIC_RESPONSE   1
+#define SIM_METRIC_TURNAROUND 2
+#define SIM_METRIC_COUNT      3
+
+const char* sim_metric_names[SIM_METRIC_COUNT] = {"Waiting", "Response", "Turnaround"};
+
+// One histogram per task class and metric, fed on every completion (ns).
+// Percentiles come from here instead of sorting the process table, and the
+// histograms of several runs merge by addition.
+typedef struct {
+    Histogram hist[TASK_CLASS_COUNT][SIM_METRIC_COUNT];
+} SimLatency;
+
+void sim_latency_init(SimLatency* latency) {
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        for (int m = 0; m < SIM_METRIC_COUNT; m++) {
+            hist_init(&latency->hist[c][m]);
+        }
+    }
+}
+
+// dst += src
+void sim_latency_merge(SimLatency* dst, const SimLatency* src) {
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        for (int m = 0; m < SIM_METRIC_COUNT; m++) {
+            hist_merge(&dst->hist[c][m], &src->hist[c][m]);
+        }
+    }
+}
+
+// Lateness buckets (ms past the deadline) for the distribution table
+#define SIM_LATENESS_BUCKETS 6
+const double sim_lateness_bounds_ms[SIM_LATENESS_BUCKETS - 1] = {1, 5, 20, 100, 500};
+const char* sim_lateness_labels[SIM_LATENESS_BUCKETS] = {"<=1", "1-5", "5-20", "20-100", "100-500", ">500"};
+
+// SLA deadline outcomes per class, counted on every completion
+typedef struct {
+    long long missed[TASK_CLASS_COUNT];
+    double lateness[TASK_CLASS_COUNT];      // ns past the deadline, summed over misses
+    sim_time_t max_lateness[TASK_CLASS_COUNT];
+    long long buckets[TASK_CLASS_COUNT][SIM_LATENESS_BUCKETS];
+} SimDeadlines;
+
+// Arrivals produced one record at a time (sim_set_source), e.g. straight
+// from the workload generator; next returns 0 once the stream has ended
+typedef struct {
+    void* ctx;
+    int (*next)(void* ctx, WorkloadRecord* rec);
+    void (*close)(void* ctx); // optional, called by sim_free
+    const char* name;        // for error messages
+} SimSource;
+
+// SimCpu.last_task of a task whose slot was released (streaming): the next
+// task in that slot is a different one and pays a full context switch
+#define SIM_TASK_RELEASED -2
+
+struct SchedSim {
+    LinuxProcess* procs;     // arrived processes, in arrival order unless streaming
+    int count;               // slots handed out (every admitted task unless streaming)
+    int capacity;
+    int streaming;           // sim_enable_streaming: finished tasks give their slot back
+    int* free_slots;         // released slots, reused before count grows
+    int nfree;
+    const SchedPolicy* policy;
+    const SchedHooks* hooks;
+
+    SimCpu* cpus;
+    int ncpus;
+    int current_cpu;         // CPU of the event being handled (for hooks)
+    int balance;             // SIM_BALANCE_*
+    sim_time_t balance_period;
+
+    const Workload* workload;
+    size_t next_record;      // cursor over workload->records
+    SimSource source;        // replaces workload when next != NULL
+    WorkloadRecord source_record;
+    int source_pending;      // source_record is read but not admitted yet
+    int source_done;
+    long long admitted;      // tasks that have arrived so far
+    sim_time_t last_arrival;
+
+    sim_time_t current_time;
+    sim_time_t switch_cost;    // charged when a CPU moves to a different task
+    sim_time_t migration_cost; // extra charge when a task changes CPU
+    long long completed_count;
+
+    // Metric accumulation
+    sim_time_t total_burst_time;
+    sim_time_t total_idle_time;
+    sim_time_t total_switch_time;
+    int total_context_switches;
+    int total_preemptions;
+    int total_migrations;
+    SimLatency* latency;     // per class and metric, one record per completion
+    SimDeadlines deadlines;
+
+    // Execution slices in the order they ended (contiguous runs are merged)
+    GanttBuffer gantt;
+    int gantt_off;           // sim_disable_gantt: no slices are kept
+
+    // Event stream for schedule export, emit == NULL when off
+    SimTracer tracer;
+
+    // Real-time replay (sim_enable_realtime); virtual time never sleeps
+    int realtime;
+    struct timespec replay_origin;    // CLOCK_MONOTONIC at simulated time 0
+    sim_time_t replay_max_lateness;   // worst wake-up past an event's deadline
+    sim_time_t replay_total_lateness;
+    long long replay_waits;
+
+    // Burst prediction (sim_enable_prediction): policies see an exponential
+    // average of the bursts completed per task kind instead of burst_time
+    int predict_bursts;
+    double predict_alpha;                         // weight of the newest burst
+    sim_time_t burst_estimate[TASK_KIND_COUNT];
+    sim_time_t total_prediction_error;            // sum of |predicted - actual|
+};
+
+// Replace the CPU set; call before sim_run. Each CPU gets its own ready queue.
+void sim_set_cpus(SchedSim* sim, int ncpus) {
+    for (int c = 0; c < sim->ncpus; c++) {
+        if (sim->policy->destroy) {
+            sim->policy->destroy(sim->cpus[c].rq);
+        }
+    }
+    free(sim->cpus);
+
+    sim->cpus = (SimCpu*)calloc(ncpus, sizeof(SimCpu));
+    if (sim->cpus == NULL) {
+        perror("sim_set_cpus: calloc failed");
+        exit(1);
+    }
+    sim->ncpus = ncpus;
+    for (int c = 0; c < ncpus; c++) {
+        SimCpu* cpu = &sim->cpus[c];
+        cpu->running = -1;
+        cpu->last_task = -1;
+        cpu->idle_since = 0;
+        cpu->rq = sim->policy->create ? sim->policy->create(sim) : NULL;
+    }
+}
+
+void sim_init(SchedSim* sim, const SchedPolicy* policy, const Workload* workload) {
+    memset(sim, 0, sizeof(*sim));
+    sim->workload = workload;
+    sim->policy = policy;
+    sim->switch_cost = MS_TO_NS(sim_host.context_switch_ms);
+    sim->migration_cost = MIGRATION_COST_LINUX_NS;
+    sim->balance = SIM_BALANCE_STEAL;
+    sim->balance_period = MS_TO_NS(4);
+    sim->latency = (SimLatency*)malloc(sizeof(SimLatency));
+    if (sim->latency == NULL) {
+        perror("sim_init: malloc failed");
+        exit(1);
+    }
+    sim_latency_init(sim->latency);
+    gantt_init(&sim->gantt);
+    sim_set_cpus(sim, 1);
+}
+
+// Pace the run against the wall clock: every scheduling event is released
+// at origin + simulated time. Deadlines are absolute (TIMER_ABSTIME), so a
+// late wake-up or slow hook never pushes later events back and drift
+// cannot accumulate the way it does with relative usleep() calls.
+void sim_enable_realtime(SchedSim* sim) {
+    sim->realtime = 1;
+}
+
+// Runs that only report metrics need no slice log; for long traces it is
+// by far the largest allocation
+void sim_disable_gantt(SchedSim* sim) {
+    sim->gantt_off = 1;
+}
+
+// Constant-memory runs: a task's slot in the process table is released as
+// soon as it completes, so only tasks still in the system are held and an
+// arrival stream of any length fits. Per-task results are gone afterwards
+// (no process table, no Gantt chart); every metric report and the summary
+// still work, since they read the accumulators filled at completion.
+void sim_enable_streaming(SchedSim* sim) {
+    sim->streaming = 1;
+    sim_disable_gantt(sim);
+}
+
+// Read arrivals from source instead of the workload array; call before sim_run
+void sim_set_source(SchedSim* sim, int (*next)(void* ctx, WorkloadRecord* rec), void* ctx, const char* name) {
+    sim->source.next = next;
+    sim->source.ctx = ctx;
+    sim->source.name = name;
+}
+
+// tau(n+1) = alpha * t(n) + (1 - alpha) * tau(n), per task kind, starting
+// from initial for every kind
+void sim_enable_prediction(SchedSim* sim, double alpha, sim_time_t initial) {
+    sim->predict_bursts = 1;
+    sim->predict_alpha = alpha;
+    for (int k = 0; k < TASK_KIND_COUNT; k++) {
+        sim->burst_estimate[k] = initial;
+    }
+}
+
+void sim_replay_wait(SchedSim* sim) {
+    if (!sim->realtime) return;
+
+    struct timespec deadline = sim->replay_origin;
+    deadline.tv_sec += sim->current_time / 1000000000LL;
+    deadline.tv_nsec += sim->current_time % 1000000000LL;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sim_time_t lateness = (now.tv_sec - deadline.tv_sec) * 1000000000LL + (now.tv_nsec - deadline.tv_nsec);
+    if (lateness > sim->replay_max_lateness) {
+        sim->replay_max_lateness = lateness;
+    }
+    sim->replay_total_lateness += lateness;
+    sim->replay_waits++;
+}
+
+void sim_trace(SchedSim* sim, int type, int cpu, int task, sim_time_t start, sim_time_t end, int reason) {
+    if (sim->tracer.emit == NULL) return;
+    SimTraceEvent event = { type, cpu, task, start, end, reason };
+    sim->tracer.emit(sim->tracer.ctx, sim, &event);
+}
+
+void sim_free(SchedSim* sim) {
+    if (sim->tracer.close) {
+        sim->tracer.close(sim->tracer.ctx);
+    }
+    if (sim->source.close) {
+        sim->source.close(sim->source.ctx);
+    }
+    for (int c = 0; c < sim->ncpus; c++) {
+        if (sim->policy->destroy) {
+            sim->policy->destroy(sim->cpus[c].rq);
+        }
+    }
+    free(sim->cpus);
+    free(sim->procs);
+    free(sim->free_slots);
+    free(sim->latency);
+    gantt_free(&sim->gantt);
+    sim->cpus = NULL;
+    sim->procs = NULL;
+    sim->free_slots = NULL;
+    sim->latency = NULL;
+}
+
+// Put an arriving record in the process table (a released slot if there
+// is one), returns its index
+int sim_add_process(SchedSim* sim, const WorkloadRecord* rec) {
+    int task;
+    if (sim->nfree > 0) {
+        task = sim->free_slots[--sim->nfree];
+    } else {
+        if (sim->count == sim->capacity) {
+            int capacity = sim->capacity ? sim->capacity * 2 : 64;
+            LinuxProcess* grown = (LinuxProcess*)realloc(sim->procs, sizeof(LinuxProcess) * capacity);
+            if (grown == NULL) {
+                perror("sim_add_process: realloc failed");
+                exit(1);
+            }
+            sim->procs = grown;
+            sim->capacity = capacity;
+            if (sim->streaming) {
+                int* slots = (int*)realloc(sim->free_slots, sizeof(int) * capacity);
+                if (slots == NULL) {
+                    perror("sim_add_process: realloc failed");
+                    exit(1);
+                }
+                sim->free_slots = slots;
+            }
+        }
+        task = sim->count++;
+    }
+
+    int kind = rec->kind < TASK_KIND_COUNT ? rec->kind : TASK_KIND_BACKGROUND;
+    LinuxProcess* p = &sim->procs[task];
+    memset(p, 0, sizeof(*p));
+    snprintf(p->pid, sizeof(p->pid), "P%u", rec->pid);
+    p->id = rec->pid;
+    p->description = task_kinds[kind].description;
+    p->kind = kind;
+    p->task_class = task_kinds[kind].task_class;
+    p->process_type = task_class_names[p->task_class];
+    p->arrival_time = rec->arrival_ns;
+    p->burst_time = rec->burst_ns;
+    p->priority = rec->priority;
+    p->deadline = p->arrival_time + MS_TO_NS(rec->deadline_ms ? rec->deadline_ms : task_kinds[kind].sla_ms);
+    p->remaining_time = p->burst_time;
+    p->predicted_burst = sim->predict_bursts ? sim->burst_estimate[kind] : p->burst_time;
+    p->start_time = -1;
+    p->response_time = -1;
+    p->last_cpu = -1;
+    p->seq = sim->admitted++;
+    return task;
+}
+
+// Streaming: hand a finished task's slot back for the next arrival
+void sim_release_task(SchedSim* sim, int task) {
+    for (int c = 0; c < sim->ncpus; c++) {
+        if (sim->cpus[c].last_task == task) {
+            sim->cpus[c].last_task = SIM_TASK_RELEASED;
+        }
+    }
+    sim->free_slots[sim->nfree++] = task;
+}
+
+void sim_record_slice(SchedSim* sim, int cpu, int task, sim_time_t start, sim_time_t end) {
+    if (sim->gantt_off) return;
+    GanttEvent* last = gantt_last(&sim->gantt);
+    if (last != NULL && last->process_index == task && last->cpu == cpu && last->end_time == start) {
+        last->end_time = end;
+        return;
+    }
+    gantt_append(&sim->gantt, cpu, task, start, end);
+}
+
+// Queue a ready task on a CPU's runqueue. Preemption is checked once the
+// current event has been fully processed.
+void sim_enqueue(SchedSim* sim, int cpu, int task, int reason, int first) {
+    SimCpu* c = &sim->cpus[cpu];
+    sim->procs[task].ready_since = sim->current_time;
+    if (first) {
+        sim->policy->on_arrival(sim, c->rq, task);
+    } else {
+        sim->policy->on_preempt(sim, c->rq, task, reason);
+    }
+    c->nr_queued++;
+    if (c->running != -1) {
+        c->recheck = 1;
+    }
+}
+
+// CPU for a new arrival: an idle one if any, else the least loaded
+int sim_place_task(const SchedSim* sim) {
+    int best = 0;
+    int best_load = -1;
+    for (int c = 0; c < sim->ncpus; c++) {
+        const SimCpu* cpu = &sim->cpus[c];
+        int load = cpu->nr_queued + (cpu->running != -1);
+        if (best_load == -1 || load < best_load) {
+            best = c;
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+// Next record not yet admitted, NULL once the workload or source is exhausted
+const WorkloadRecord* sim_peek_record(SchedSim* sim) {
+    if (sim->source.next == NULL) {
+        if (sim->next_record >= sim->workload->count) return NULL;
+        return &sim->workload->records[sim->next_record];
+    }
+    if (!sim->source_pending && !sim->source_done) {
+        if (sim->source.next(sim->source.ctx, &sim->source_record)) {
+            sim->source_pending = 1;
+        } else {
+            sim->source_done = 1;
+        }
+    }
+    return sim->source_pending ? &sim->source_record : NULL;
+}
+
+// Hand every process whose arrival time has passed to the policy.
+// Returns how many were admitted.
+int sim_admit_arrivals(SchedSim* sim) {
+    int admitted = 0;
+    const WorkloadRecord* rec;
+    while ((rec = sim_peek_record(sim)) != NULL) {
+        if (rec->arrival_ns > sim->current_time) break;
+        if (sim->admitted > 0 && rec->arrival_ns < sim->last_arrival) {
+            fprintf(stderr, "%s: record %lld arrives out of order\n",
+                    sim->source.next ? sim->source.name : sim->workload->name, sim->admitted);
+            exit(1);
+        }
+        sim->last_arrival = rec->arrival_ns;
+        int task = sim_add_process(sim, rec);
+        if (sim->source.next) {
+            sim->source_pending = 0;
+        } else {
+            sim->next_record++;
+        }
+        sim_enqueue(sim, sim_place_task(sim), task, 0, 1);
+        admitted++;
+    }
+    return admitted;
+}
+
+// Arrival time of the next process not yet admitted, -1 if none are left
+sim_time_t sim_next_arrival_time(SchedSim* sim) {
+    const WorkloadRecord* rec = sim_peek_record(sim);
+    return rec ? rec->arrival_ns : -1;
+}
+
+int sim_has_work(SchedSim* sim) {
+    return sim->completed_count < sim->admitted || sim_peek_record(sim) != NULL;
+}
+
+// CPU with the most queued tasks other than except, -1 if all are empty
+int sim_busiest_cpu(const SchedSim* sim, int except) {
+    int busiest = -1;
+    for (int c = 0; c < sim->ncpus; c++) {
+        if (c == except || sim->cpus[c].nr_queued == 0) continue;
+        if (busiest == -1 || sim->cpus[c].nr_queued > sim->cpus[busiest].nr_queued) {
+            busiest = c;
+        }
+    }
+    return busiest;
+}
+
+// Move the task from's policy would run next onto to's queue.
+// Returns 0 if from had nothing queued.
+int sim_migrate_queued(SchedSim* sim, int from, int to) {
+    int task = sim->policy->select_next(sim, sim->cpus[from].rq);
+    if (task == -1) return 0;
+    sim->cpus[from].nr_queued--;
+    sim_enqueue(sim, to, task, SCHED_REQUEUE_MIGRATE, 0);
+    return 1;
+}
+
+// Next task for a CPU from its own queue, -1 if empty. With work stealing
+// an idle CPU first pulls the task the busiest CPU would have run next.
+int sim_select(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    if (c->nr_queued == 0 && sim->ncpus > 1 && sim->balance == SIM_BALANCE_STEAL) {
+        int victim = sim_busiest_cpu(sim, cpu);
+        if (victim != -1) {
+            sim_migrate_queued(sim, victim, cpu);
+        }
+    }
+    int task = sim->policy->select_next(sim, c->rq);
+    if (task != -1) {
+        c->nr_queued--;
+    }
+    return task;
+}
+
+// Time at which the running task completes or its quantum expires
+void sim_schedule_run(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    const LinuxProcess* p = &sim->procs[c->running];
+    sim_time_t run = p->remaining_time;
+    if (c->quantum > 0 && c->quantum - c->slice_used < run) {
+        run = c->quantum - c->slice_used;
+    }
+    c->event_time = c->accounted + run;
+    if (sim->policy->preempt_time) {
+        sim_time_t at = sim->policy->preempt_time(sim, c->rq, c->running);
+        if (at > c->accounted && at < c->event_time) c->event_time = at;
+    }
+}
+
+// The dispatched task actually starts executing (after any switch)
+void sim_start_task(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    int task = c->running;
+    LinuxProcess* p = &sim->procs[task];
+
+    c->switching = 0;
+    c->run_start = sim->current_time;
+    c->accounted = sim->current_time;
+    sim_schedule_run(sim, cpu);
+
+    int first_run = p->start_time == -1;
+    if (first_run) {
+        p->start_time = sim->current_time;
+        p->response_time = p->start_time - p->arrival_time;
+    }
+    sim->current_cpu = cpu;
+    if (sim->hooks && sim->hooks->on_dispatch) {
+        sim->hooks->on_dispatch(sim, task, first_run);
+    }
+}
+
+void sim_dispatch(SchedSim* sim, int cpu, int task) {
+    SimCpu* c = &sim->cpus[cpu];
+    LinuxProcess* p = &sim->procs[task];
+
+    if (c->idle_since != -1) {
+        if (sim->current_time > c->idle_since) {
+            c->idle_time += sim->current_time - c->idle_since;
+            sim->total_idle_time += sim->current_time - c->idle_since;
+            sim_trace(sim, SIM_TRACE_IDLE, cpu, -1, c->idle_since, sim->current_time, 0);
+        }
+        c->idle_since = -1;
+    }
+
+    sim_time_t cost = 0;
+    if (c->last_task != -1 && c->last_task != task) {
+        cost += sim->switch_cost;
+        c->context_switches++;
+        sim->total_context_switches++;
+    }
+    if (p->last_cpu != -1 && p->last_cpu != cpu) {
+        cost += sim->migration_cost;
+        c->migrations++;
+        p->migrations++;
+        sim->total_migrations++;
+    }
+    c->running = task;
+    c->last_task = task;
+    c->slice_used = 0;
+    c->quantum = sim->policy->time_slice ? sim->policy->time_slice(sim, c->rq, task) : sim->policy->quantum;
+    p->last_cpu = cpu;
+
+    if (cost > 0) {
+        c->switching = 1;
+        c->event_time = sim->current_time + cost;
+        c->switch_time += cost;
+        sim->total_switch_time += cost;
+        sim_trace(sim, SIM_TRACE_SWITCH, cpu, task, sim->current_time, c->event_time, 0);
+    } else {
+        sim_start_task(sim, cpu);
+    }
+}
+
+// Bring the running task's remaining time up to the current instant
+void sim_sync(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    if (c->running == -1 || c->switching) return;
+    sim_time_t elapsed = sim->current_time - c->accounted;
+    sim->procs[c->running].remaining_time -= elapsed;
+    c->slice_used += elapsed;
+    c->accounted = sim->current_time;
+}
+
+// Task on the CPU that owns rq (running or being switched in), -1 if that
+// CPU is idle. Its remaining_time is brought up to the current instant, so
+// policies can compare it with queued tasks at any point.
+int sim_rq_current(SchedSim* sim, const void* rq) {
+    for (int c = 0; c < sim->ncpus; c++) {
+        if (sim->cpus[c].rq == rq) {
+            sim_sync(sim, c);
+            return sim->cpus[c].running;
+        }
+    }
+    return -1;
+}
+
+// The running task stops executing now: record its stretch
+void sim_end_stretch(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    sim_sync(sim, cpu);
+    if (sim->current_time > c->run_start) {
+        sim_record_slice(sim, cpu, c->running, c->run_start, sim->current_time);
+        sim_trace(sim, SIM_TRACE_SLICE, cpu, c->running, c->run_start, sim->current_time, 0);
+        c->busy_time += sim->current_time - c->run_start;
+    }
+    c->run_start = sim->current_time;
+}
+
+void sim_complete(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    int task = c->running;
+    LinuxProcess* p = &sim->procs[task];
+
+    p->completed = 1;
+    p->exit_time = sim->current_time;
+    p->turnaround_time = p->exit_time - p->arrival_time;
+    p->waiting_time = p->turnaround_time - p->burst_time;
+
+    sim->total_burst_time += p->burst_time;
+    sim->completed_count++;
+    Histogram* hist = sim->latency->hist[p->task_class];
+    hist_record(&hist[SIM_METRIC_WAIT], (uint64_t)p->waiting_time);
+    hist_record(&hist[SIM_METRIC_RESPONSE], (uint64_t)p->response_time);
+    hist_record(&hist[SIM_METRIC_TURNAROUND], (uint64_t)p->turnaround_time);
+    sim_time_t late = p->exit_time - p->deadline;
+    if (late > 0) {
+        SimDeadlines* d = &sim->deadlines;
+        int b = 0;
+        while (b < SIM_LATENESS_BUCKETS - 1 && sim_ms(late) > sim_lateness_bounds_ms[b]) b++;
+        d->missed[p->task_class]++;
+        d->lateness[p->task_class] += (double)late;
+        if (late > d->max_lateness[p->task_class]) d->max_lateness[p->task_class] = late;
+        d->buckets[p->task_class][b]++;
+    }
+    c->running = -1;
+
+    if (sim->predict_bursts) {
+        sim_time_t error = p->predicted_burst - p->burst_time;
+        sim->total_prediction_error += error < 0 ? -error : error;
+        sim_time_t* estimate = &sim->burst_estimate[p->kind];
+        *estimate = (sim_time_t)(sim->predict_alpha * p->burst_time + (1.0 - sim->predict_alpha) * *estimate);
+    }
+    c->idle_since = sim->current_time;
+
+    if (sim->policy->on_complete) {
+        sim->policy->on_complete(sim, c->rq, task);
+    }
+    sim->current_cpu = cpu;
+    if (sim->hooks && sim->hooks->on_complete) {
+        sim->hooks->on_complete(sim, task);
+    }
+    if (sim->streaming) {
+        sim_release_task(sim, task);
+    }
+}
+
+void sim_preempt(SchedSim* sim, int cpu, int reason) {
+    SimCpu* c = &sim->cpus[cpu];
+    int task = c->running;
+    sim->procs[task].preemptions++;
+    sim->total_preemptions++;
+    c->running = -1;
+    c->switching = 0;
+    c->idle_since = sim->current_time;
+    sim_trace(sim, SIM_TRACE_PREEMPT, cpu, task, sim->current_time, sim->current_time, reason);
+
+    // The preempted task is queued before anything that arrived during its slice
+    sim_enqueue(sim, cpu, task, reason, 0);
+    sim_admit_arrivals(sim);
+
+    int next = sim_select(sim, cpu);
+    sim->current_cpu = cpu;
+    if (sim->hooks && sim->hooks->on_preempt) {
+        sim->hooks->on_preempt(sim, task, next, reason);
+    }
+    if (next != -1) {
+        sim_dispatch(sim, cpu, next);
+    }
+}
+
+// A CPU reached its event time: switch finished, task finished, or quantum used up
+void sim_cpu_event(SchedSim* sim, int cpu) {
+    SimCpu* c = &sim->cpus[cpu];
+    if (c->switching) {
+        sim_start_task(sim, cpu);
+        return;
+    }
+    sim_sync(sim, cpu);
+    if (sim->procs[c->running].remaining_time == 0) {
+        sim_end_stretch(sim, cpu);
+        sim_complete(sim, cpu);
+    } else if (c->quantum > 0 && c->slice_used >= c->quantum) {
+        sim_end_stretch(sim, cpu);
+        sim_preempt(sim, cpu, SCHED_PREEMPT_QUANTUM);
+    } else {
+        // Woken at the policy's preempt_time: the recheck pass decides
+        c->recheck = 1;
+        sim_schedule_run(sim, cpu);
+    }
+}
+
+// Periodic rebalancing: move queued tasks from the longest to the shortest
+// queue until no two CPUs differ by more than one task
+void sim_rebalance(SchedSim* sim) {
+    for (;;) {
+        int longest = 0;
+        int shortest = 0;
+        for (int c = 1; c < sim->ncpus; c++) {
+            if (sim->cpus[c].nr_queued > sim->cpus[longest].nr_queued) longest = c;
+            if (sim->cpus[c].nr_queued < sim->cpus[shortest].nr_queued) shortest = c;
+        }
+        if (sim->cpus[longest].nr_queued - sim->cpus[shortest].nr_queued <= 1) return;
+        if (!sim_migrate_queued(sim, longest, shortest)) return;
+    }
+}
+
+// Discrete-event loop over all CPUs: the clock jumps straight to the next
+// arrival, switch completion, task completion or quantum expiry, so the cost
+// scales with the number of scheduling events rather than with simulated
+// time. Events at the same instant are handled CPU events first, then
+// arrivals, then preemption checks, then idle CPUs pick up work.
+void sim_run(SchedSim* sim, const SchedHooks* hooks) {
+    const SchedPolicy* policy = sim->policy;
+    sim->hooks = hooks;
+    if (sim->realtime) {
+        clock_gettime(CLOCK_MONOTONIC, &sim->replay_origin);
+    }
+    int periodic = sim->ncpus > 1 && sim->balance == SIM_BALANCE_PERIODIC;
+
+    while (sim_has_work(sim)) {
+        // Next event time. Arrivals are only events if they can change what
+        // runs: with every CPU busy and no check_preempt they are admitted at
+        // the next completion or quantum expiry, behind the preempted task.
+        sim_time_t next = -1;
+        int queued = 0;
+        int idle = 0;
+        for (int c = 0; c < sim->ncpus; c++) {
+            const SimCpu* cpu = &sim->cpus[c];
+            if (cpu->running == -1) {
+                idle = 1;
+            } else if (next < 0 || cpu->event_time < next) {
+                next = cpu->event_time;
+            }
+            queued += cpu->nr_queued;
+        }
+        sim_time_t arrival = sim_next_arrival_time(sim);
+        if (arrival >= 0 && (idle || policy->check_preempt) && (next < 0 || arrival < next)) {
+            next = arrival;
+        }
+        sim_time_t balance_at = -1;
+        if (periodic && queued > 0) {
+            balance_at = (sim->current_time / sim->balance_period + 1) * sim->balance_period;
+            if (next < 0 || balance_at < next) next = balance_at;
+        }
+        if (next < 0) break;
+
+        if (next > sim->current_time) {
+            sim->current_time = next;
+            sim_replay_wait(sim);
+        }
+
+        for (int c = 0; c < sim->ncpus; c++) {
+            if (sim->cpus[c].running != -1 && sim->cpus[c].event_time == sim->current_time) {
+                sim_cpu_event(sim, c);
+            }
+        }
+
+        sim_admit_arrivals(sim);
+        if (balance_at == sim->current_time) {
+            sim_rebalance(sim);
+        }
+
+        for (int c = 0; c < sim->ncpus; c++) {
+            SimCpu* cpu = &sim->cpus[c];
+            if (!cpu->recheck || cpu->switching) continue;
+            cpu->recheck = 0;
+            if (cpu->running != -1 && policy->check_preempt) {
+                sim_sync(sim, c);
+                if (policy->check_preempt(sim, cpu->rq, cpu->running)) {
+                    sim_end_stretch(sim, c);
+                    sim_preempt(sim, c, SCHED_PREEMPT_PRIORITY);
+                } else {
+                    sim_schedule_run(sim, c);
+                }
+            }
+        }
+
+        for (int c = 0; c < sim->ncpus; c++) {
+            if (sim->cpus[c].running == -1) {
+                int task = sim_select(sim, c);
+                if (task != -1) {
+                    sim_dispatch(sim, c, task);
+                }
+            }
+        }
+    }
+
+    // CPUs that ran out of work before the last task finished were idle
+    for (int c = 0; c < sim->ncpus; c++) {
+        SimCpu* cpu = &sim->cpus[c];
+        if (cpu->running == -1 && cpu->idle_since != -1 && sim->current_time > cpu->idle_since) {
+            cpu->idle_time += sim->current_time - cpu->idle_since;
+            sim->total_idle_time += sim->current_time - cpu->idle_since;
+            sim_trace(sim, SIM_TRACE_IDLE, c, -1, cpu->idle_since, sim->current_time, 0);
+            cpu->idle_since = sim->current_time;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Reporting shared by every simulator
+// ---------------------------------------------------------------------------
+
+// Share of total CPU capacity (all CPUs) spent running tasks
+double sim_cpu_utilization(const SchedSim* sim) {
+    if (sim->current_time == 0) return 0.0;
+    return (sim->total_burst_time * 100.0) / ((double)sim->current_time * sim->ncpus);
+}
+
+#define SIM_GANTT_MAX_COLUMNS  120 // chart width; the rest of the run is cut off with a note
+#define SIM_GANTT_MAX_SEQUENCE 50  // runs listed in the execution sequence
+
+// One chart row with its trailing blanks trimmed
+void sim_print_gantt_row(const char* prefix, const char* row, int width) {
+    while (width > 0 && row[width - 1] == ' ') width--;
+    printf("%s%.*s\n", prefix, width, row);
+}
+
+// Execution sequence of one CPU (all slices if cpu is -1), cut after
+// SIM_GANTT_MAX_SEQUENCE runs
+void sim_print_gantt_sequence(const SchedSim* sim, int cpu, const char* indent) {
+    long long listed = 0;
+    long long runs = 0;
+    for (long long i = 0; i < sim->gantt.count; i++) {
+        GanttEvent e = gantt_get(&sim->gantt, i);
+        if (cpu >= 0 && e.cpu != cpu) continue;
+        runs++;
+        if (listed == SIM_GANTT_MAX_SEQUENCE) continue;
+        if (listed > 0) printf(listed % 10 == 0 ? " ->\n%s" : " -> ", indent);
+        printf("%s", sim->procs[e.process_index].pid);
+        listed++;
+    }
+    if (runs > listed) printf(" -> ... (%lld runs in total)", runs);
+    printf("\n");
+}
+
+// Text Gantt chart of sim->gantt on a real time axis shared by all CPUs,
+// one row per CPU, ms_per_char ms per column. Only the first
+// SIM_GANTT_MAX_COLUMNS columns are drawn and each execution sequence stops
+// after SIM_GANTT_MAX_SEQUENCE runs, with a note when anything was cut;
+// --trace exports the full schedule.
+void sim_print_gantt(const SchedSim* sim, const char* title, int ms_per_char) {
+    printf("\n================================================================================\n");
+    printf("GANTT CHART - %s\n", title);
+    printf("================================================================================\n\n");
+    if (sim->gantt.count == 0) {
+        printf("No execution events recorded.\n");
+        return;
+    }
+
+    sim_time_t scale = ms_per_char * NS_PER_MS;
+    long long needed = (sim->current_time + scale - 1) / scale;
+    int columns = needed < SIM_GANTT_MAX_COLUMNS ? (int)needed : SIM_GANTT_MAX_COLUMNS;
+    for (int cpu = 0; cpu < sim->ncpus; cpu++) {
+        char bar[SIM_GANTT_MAX_COLUMNS + 1];
+        char label[SIM_GANTT_MAX_COLUMNS + 1];
+        memset(bar, ' ', sizeof(bar));
+        memset(label, ' ', sizeof(label));
+        for (long long i = 0; i < sim->gantt.count; i++) {
+            GanttEvent e = gantt_get(&sim->gantt, i);
+            if (e.cpu != cpu) continue;
+            long long start = e.start_time / scale;
+            if (start > columns) continue;
+            long long end = e.end_time / scale;
+            if (end > columns) end = columns + 1; // runs past the cut: no closing bar
+            bar[start] = label[start] = '|';
+            for (long long c = start + 1; c < end; c++) bar[c] = '-';
+            if (end <= columns) bar[end] = label[end] = '|';
+
+            // Centered in the block when it fits, left out otherwise
+            const char* pid = sim->procs[e.process_index].pid;
+            long long room = end - start - 1;
+            long long len = (long long)strlen(pid);
+            if (room >= len) {
+                memcpy(&label[start + 1 + (room - len) / 2], pid, len);
+            }
+        }
+        char prefix[16] = "         ";
+        if (sim->ncpus > 1) {
+            snprintf(prefix, sizeof(prefix), "CPU %-5d", cpu);
+        }
+        sim_print_gantt_row(prefix, bar, columns + 1);
+        sim_print_gantt_row("         ", label, columns + 1);
+    }
+
+    // Time markers every 10 columns, where there is room for them
+    char axis[SIM_GANTT_MAX_COLUMNS + 16];
+    memset(axis, ' ', sizeof(axis));
+    int free_from = 0;
+    for (int c = 0; c <= columns; c += 10) {
+        if (c < free_from) continue;
+        char mark[16];
+        int n = snprintf(mark, sizeof(mark), "%d", c * ms_per_char);
+        memcpy(&axis[c], mark, n);
+        free_from = c + n + 1;
+    }
+    sim_print_gantt_row("Time(ms) ", axis, free_from);
+
+    if (sim->ncpus == 1) {
+        printf("\nExecution Sequence: ");
+        sim_print_gantt_sequence(sim, -1, "                    ");
+    } else {
+        printf("\nExecution Sequence:\n");
+        for (int cpu = 0; cpu < sim->ncpus; cpu++) {
+            printf("  CPU %-4d ", cpu);
+            sim_print_gantt_sequence(sim, cpu, "           ");
+        }
+    }
+
+    printf("\nNote: Each '-' character represents %dms of execution time\n", ms_per_char);
+    if (needed > columns) {
+        printf("      Chart shows the first %d ms of %.3f ms; --trace FILE exports the full schedule\n",
+               columns * ms_per_char, sim_ms(sim->current_time));
+    }
+}
+
+void sim_print_process_table(const Workload* workload, const char* heading) {
+    printf("\n%s\n", heading);
+    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
+    printf("| PID | Task Description                 | Type         | Arrival  | Burst    | Priority |\n");
+    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
+
+    for (size_t i = 0; i < workload->count; i++) {
+        const WorkloadRecord* rec = &workload->records[i];
+        const TaskKind* kind = &task_kinds[rec->kind < TASK_KIND_COUNT ? rec->kind : TASK_KIND_BACKGROUND];
+        char pid[12];
+        snprintf(pid, sizeof(pid), "P%u", rec->pid);
+        printf("| %-3s | %-32s | %-12s | %-8g | %-8g | %-8d |\n",
+               pid,
+               kind->description,
+               task_class_names[kind->task_class],
+               sim_ms(rec->arrival_ns),
+               sim_ms(rec->burst_ns),
+               rec->priority);
+    }
+    printf("+-----+----------------------------------+--------------+----------+----------+----------+\n");
+}
+
+// Mean of one class and metric, or of all classes if task_class is -1, in
+// ms. Sums are kept in double: ns totals of a long overloaded run can
+// exceed 64 bits.
+double sim_latency_mean(const SchedSim* sim, int task_class, int metric) {
+    double sum = 0.0;
+    uint64_t count = 0;
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        if (task_class >= 0 && c != task_class) continue;
+        sum += sim->latency->hist[c][metric].sum;
+        count += sim->latency->hist[c][metric].count;
+    }
+    return count > 0 ? sum / NS_PER_MS / count : 0.0;
+}
+
+void sim_print_system_metrics(const SchedSim* sim, const char* title) {
+    double avg_waiting_time = sim_latency_mean(sim, -1, SIM_METRIC_WAIT);
+    double avg_turnaround_time = sim_latency_mean(sim, -1, SIM_METRIC_TURNAROUND);
+    double avg_response_time = sim_latency_mean(sim, -1, SIM_METRIC_RESPONSE);
+    double total_execution_time = sim_ms(sim->current_time);
+
+    printf("\n================================================================================\n");
+    printf("SYSTEM-WIDE PERFORMANCE METRICS%s\n", title);
+    printf("================================================================================\n");
+
+    printf("\nAverage Waiting Time:    %.2f ms\n", avg_waiting_time);
+    printf("Average Response Time:   %.2f ms\n", avg_response_time);
+    printf("Average Turnaround Time: %.2f ms\n", avg_turnaround_time);
+    printf("CPU Utilization:         %.1f%%\n", sim_cpu_utilization(sim));
+    printf("Throughput:              %.2f processes/second\n",
+           total_execution_time > 0 ? sim->completed_count / (total_execution_time / 1000.0) : 0.0);
+    printf("Total Preemptions:       %d\n", sim->total_preemptions);
+    printf("Total Context Switches:  %d\n", sim->total_context_switches);
+    printf("Context Switch Overhead: %.3f ms\n", sim_ms(sim->total_switch_time));
+    printf("Total Execution Time:    %.3f ms\n", total_execution_time);
+    printf("Total CPU Busy Time:     %.3f ms\n", sim_ms(sim->total_burst_time));
+    printf("Total Idle Time:         %.3f ms\n", sim_ms(sim->total_idle_time));
+    if (sim->ncpus > 1) {
+        printf("CPUs:                    %d (%s balancing)\n", sim->ncpus, sim_balance_names[sim->balance]);
+        printf("Total Migrations:        %d\n", sim->total_migrations);
+        printf("\n+-----+--------------+--------+----------+------------+\n");
+        printf("| CPU | Busy (ms)    | Util   | Switches | Migrations |\n");
+        printf("+-----+--------------+--------+----------+------------+\n");
+        for (int c = 0; c < sim->ncpus; c++) {
+            const SimCpu* cpu = &sim->cpus[c];
+            printf("| %-3d | %-12.3f | %5.1f%% | %-8d | %-10d |\n",
+                   c,
+                   sim_ms(cpu->busy_time),
+                   sim->current_time ? cpu->busy_time * 100.0 / sim->current_time : 0.0,
+                   cpu->context_switches,
+                   cpu->migrations);
+        }
+        printf("+-----+--------------+--------+----------+------------+\n");
+    }
+    if (sim->predict_bursts) {
+        printf("Burst Prediction:        alpha %.2f, mean abs error %.3f ms (mean burst %.3f ms)\n",
+               sim->predict_alpha,
+               sim->completed_count ? sim_ms(sim->total_prediction_error) / sim->completed_count : 0.0,
+               sim->completed_count ? sim_ms(sim->total_burst_time) / sim->completed_count : 0.0);
+    }
+    if (sim->realtime) {
+        printf("Real-Time Replay:        %lld events, max lateness %.3f ms, mean %.3f ms\n",
+               sim->replay_waits,
+               sim_ms(sim->replay_max_lateness),
+               sim->replay_waits ? sim_ms(sim->replay_total_lateness) / sim->replay_waits : 0.0);
+    }
+}
+
+// Foreground (POS) vs Background (LPUS) averages over completed tasks
+void sim_print_class_metrics(const SchedSim* sim, const char* title) {
+
+    printf("\n================================================================================\n");
+    printf("CLASS PERFORMANCE METRICS%s\n", title);
+    printf("================================================================================\n");
+    printf("\n+--------------+------------+------------+------------+------------+------------+------------+\n");
+    printf("| Class        | Tasks      | Avg Wait   | Max Wait   | Avg Resp   | Max Resp   | Avg Turn   |\n");
+    printf("+--------------+------------+------------+------------+------------+------------+------------+\n");
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        const Histogram* hist = sim->latency->hist[c];
+        printf("| %-12s | %-10lld | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f |\n",
+               task_class_names[c],
+               (long long)hist[SIM_METRIC_WAIT].count,
+               sim_latency_mean(sim, c, SIM_METRIC_WAIT),
+               sim_ms((sim_time_t)hist[SIM_METRIC_WAIT].max),
+               sim_latency_mean(sim, c, SIM_METRIC_RESPONSE),
+               sim_ms((sim_time_t)hist[SIM_METRIC_RESPONSE].max),
+               sim_latency_mean(sim, c, SIM_METRIC_TURNAROUND));
+    }
+    printf("+--------------+------------+------------+------------+------------+------------+------------+\n");
+}
+
+// Latency percentiles of one class and metric, or of all classes if
+// task_class is -1, in ms
+double sim_latency_percentile(const SchedSim* sim, int task_class, int metric, double percentile) {
+    if (task_class >= 0) {
+        return sim_ms((sim_time_t)hist_percentile(&sim->latency->hist[task_class][metric], percentile));
+    }
+    Histogram* all = (Histogram*)malloc(sizeof(Histogram));
+    if (all == NULL) {
+        perror("sim_latency_percentile: malloc failed");
+        exit(1);
+    }
+    hist_init(all);
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        hist_merge(all, &sim->latency->hist[c][metric]);
+    }
+    double value = sim_ms((sim_time_t)hist_percentile(all, percentile));
+    free(all);
+    return value;
+}
+
+// p50 to max and the spread of waiting, response and turnaround time per class
+void sim_print_tail_latency(const SchedSim* sim, const char* title) {
+    printf("\n================================================================================\n");
+    printf("TAIL LATENCY%s\n", title);
+    printf("================================================================================\n");
+    printf("\n+--------------+------------+------------+------------+------------+------------+------------+------------+\n");
+    printf("| Class        | Metric     | P50        | P90        | P99        | P99.9      | Max        | Std Dev    |\n");
+    printf("+--------------+------------+------------+------------+------------+------------+------------+------------+\n");
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        for (int m = 0; m < SIM_METRIC_COUNT; m++) {
+            const Histogram* h = &sim->latency->hist[c][m];
+            printf("| %-12s | %-10s | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f | %-10.3f |\n",
+                   m == 0 ? task_class_names[c] : "",
+                   sim_metric_names[m],
+                   sim_ms((sim_time_t)hist_percentile(h, 50.0)),
+                   sim_ms((sim_time_t)hist_percentile(h, 90.0)),
+                   sim_ms((sim_time_t)hist_percentile(h, 99.0)),
+                   sim_ms((sim_time_t)hist_percentile(h, 99.9)),
+                   h->count ? sim_ms((sim_time_t)h->max) : 0.0,
+                   hist_stddev(h) / NS_PER_MS);
+        }
+    }
+    printf("+--------------+------------+------------+------------+------------+------------+------------+------------+\n");
+    printf("Percentiles in ms, from fixed-memory histograms (within 1.6%% of the exact value);\n");
+    printf("max and standard deviation are exact\n");
+}
+
+// SLA deadline misses per class, and how late the missed tasks were
+void sim_print_deadline_metrics(const SchedSim* sim, const char* title) {
+    const SimDeadlines* d = &sim->deadlines;
+
+    printf("\n================================================================================\n");
+    printf("DEADLINE METRICS%s\n", title);
+    printf("================================================================================\n");
+    printf("\n+--------------+------------+------------+-----------+------------+------------+\n");
+    printf("| Class        | Tasks      | Misses     | Miss Rate | Avg Late   | Max Late   |\n");
+    printf("+--------------+------------+------------+-----------+------------+------------+\n");
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        long long count = (long long)sim->latency->hist[c][SIM_METRIC_WAIT].count;
+        printf("| %-12s | %-10lld | %-10lld | %8.2f%% | %-10.3f | %-10.3f |\n",
+               task_class_names[c],
+               count,
+               d->missed[c],
+               count ? d->missed[c] * 100.0 / count : 0.0,
+               d->missed[c] ? d->lateness[c] / NS_PER_MS / d->missed[c] : 0.0,
+               sim_ms(d->max_lateness[c]));
+    }
+    printf("+--------------+------------+------------+-----------+------------+------------+\n");
+
+    printf("\nLateness of missed deadlines (ms past deadline, share of misses):\n");
+    printf("%-12s", "Class");
+    for (int b = 0; b < SIM_LATENESS_BUCKETS; b++) {
+        printf(" %9s", sim_lateness_labels[b]);
+    }
+    printf("\n");
+    for (int c = 0; c < TASK_CLASS_COUNT; c++) {
+        printf("%-12s", task_class_names[c]);
+        for (int b = 0; b < SIM_LATENESS_BUCKETS; b++) {
+            printf(" %8.1f%%", d->missed[c] ? d->buckets[c][b] * 100.0 / d->missed[c] : 0.0);
+        }
+        printf("\n");
+    }
+}
+
+// Per-process results, printed in the order given (execution, priority, ...)
+// or in arrival order when order is NULL
+void sim_print_process_metrics(const SchedSim* sim, const char* title, const int* order, int n) {
+    printf("\n================================================================================\n");
+    printf("PROCESS PERFORMANCE METRICS%s\n", title);
+    printf("================================================================================\n");
+
+    printf("\n+-----+----------+----------+----------+----------+----------+------------+------------+------------+\n");
+    printf("| PID | Priority | Arrival  | Burst    | Start    | Exit     | Response   | Wait       | Turnaround |\n");
+    printf("+-----+----------+----------+----------+----------+----------+------------+------------+------------+\n");
+
+    for (int i = 0; i < n; i++) {
+        const LinuxProcess* p = &sim->procs[order ? order[i] : i];
+        printf("| %-3s | %-8d | %-8g | %-8g | %-8.3f | %-8.3f | %-10.3f | %-10.3f | %-10.3f |\n",
+               p->pid,
+               p->priority,
+               sim_ms(p->arrival_time),
+               sim_ms(p->burst_time),
+               sim_ms(p->start_time),
+               sim_ms(p->exit_time),
+               sim_ms(p->response_time),
+               sim_ms(p->waiting_time),
+               sim_ms(p->turnaround_time));
+    }
+    printf("+-----+----------+----------+----------+----------+----------+------------+------------+------------+\n");
+}
+
+// Value suffix for host figures that are Ubuntu 22.04 reference constants
+const char* sim_host_reference_mark(unsigned bit) {
+    return sim_host.measured & bit ? "" : " *";
+}
+
+// why[] holds the PrimeCart rationale for each row: interrupt latency,
+// scheduling jitter, context switch, CPU utilization, IPC throughput.
+void sim_print_threshold_analysis(const SchedSim* sim, const char* title, const char* const why[5]) {
+    double cpu_utilization = sim_cpu_utilization(sim);
+
+    printf("\n================================================================================\n");
+    printf("PRIMECART THRESHOLD ANALYSIS (Ubuntu 22.04 LTS Server%s)\n", title);
+    printf("================================================================================\n");
+    printf("Metric                 Target Threshold    Linux Value     Status   Why It Matters for PrimeCart\n");
+    printf("--------------------------------------------------------------------------------\n");
+
+    // Interrupt Latency
+    const char* int_status = sim_host.interrupt_latency_ms < 0.100 ? "PASS" : "FAIL";
+    char int_value[20];
+    sprintf(int_value, "%.3f ms%s", sim_host.interrupt_latency_ms, sim_host_reference_mark(HOST_MEASURED_LATENCY));
+    printf("Interrupt Latency      < 0.100 ms          %-12s %-6s   %s\n", int_value, int_status, why[0]);
+
+    // Scheduling Jitter
+    const char* jitter_status = sim_host.scheduling_jitter_ms < 2.000 ? "PASS" : "FAIL";
+    char jitter_value[20];
+    sprintf(jitter_value, "%.4f ms%s", sim_host.scheduling_jitter_ms, sim_host_reference_mark(HOST_MEASURED_JITTER));
+    printf("Scheduling Jitter      < 2.000 ms          %-12s %-6s   %s\n", jitter_value, jitter_status, why[1]);
+
+    // Context Switch Time
+    const char* cs_status = sim_host.context_switch_ms <= 0.010 ? "PASS" : "FAIL";
+    char cs_value[20];
+    sprintf(cs_value, "%.3f ms%s", sim_host.context_switch_ms, sim_host_reference_mark(HOST_MEASURED_SWITCH));
+    printf("Context Switch Time    < 0.010 ms          %-12s %-6s   %s\n", cs_value, cs_status, why[2]);
+
+    // CPU Utilization
+    const char* cpu_status = cpu_utilization < 75.0 ? "PASS" : "FAIL";
+    char cpu_value[20];
+    sprintf(cpu_value, "%.1f%%", cpu_utilization);
+    printf("CPU Utilization        < 75.0%%             %-12s %-6s   %s\n", cpu_value, cpu_status, why[3]);
+
+    // IPC Throughput
+    const char* ipc_status = sim_host.ipc_throughput_mbps > 500.0 ? "PASS" : "FAIL";
+    char ipc_value[20];
+    sprintf(ipc_value, "%.0f MB/s%s", sim_host.ipc_throughput_mbps, sim_host_reference_mark(HOST_MEASURED_IPC));
+    printf("IPC Throughput         > 500 MB/s          %-12s %-6s   %s\n", ipc_value, ipc_status, why[4]);
+
+    printf("--------------------------------------------------------------------------------\n");
+    if (sim_host.path != NULL) {
+        printf("Host profile: %s", sim_host.path);
+        if (sim_host.host[0]) printf(" (%s%s%s)", sim_host.host, sim_host.date[0] ? ", " : "", sim_host.date);
+        printf("\n");
+    }
+    unsigned all = HOST_MEASURED_SWITCH | HOST_MEASURED_LATENCY | HOST_MEASURED_JITTER | HOST_MEASURED_IPC;
+    if ((sim_host.measured & all) != all) {
+        printf("* Ubuntu 22.04 reference figure, not measured: run ./probe and pass --host-profile FILE\n");
+    }
+}
+
+#endif // PRIMECART_SCHED_H
@@ -0,0 +1,531 @@
+// primecart_workload.h
+// Workload definitions and trace-file loading/writing for the PrimeCart simulators.
+//
+// A workload is a read-only array of fixed-width WorkloadRecords sorted by
+// arrival time. Two on-disk formats are supported:
+//
+//   CSV     pid,type,arrival_ms,burst_ms,priority[,deadline_ms]
+//           (header line optional). pid may be written as "P12" or "12";
+//           type is a task kind name (pos_scan, lpus_batch, ...) or simply
+//           Foreground/Background. deadline_ms is the SLA deadline relative
+//           to arrival, or an absolute time when prefixed with '@'; without
+//           it the task kind's default SLA applies.
+//
+//   Binary  WorkloadFileHeader followed by count WorkloadRecords, native
+//           (little-endian) byte order. The file is memory-mapped and read
+//           in place, so multi-gigabyte traces are never copied to the heap.
+//
+// The simulator walks the records with a cursor and only materializes a
+// process when it arrives. With --stream not even the records are kept:
+// each run reads the file record by record (WorkloadStream).
+#ifndef PRIMECART_WORKLOAD_H
+#define PRIMECART_WORKLOAD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ---------------------------------------------------------------------------
+// Task kinds and classes
+// ---------------------------------------------------------------------------
+
+#define TASK_CLASS_FOREGROUND 0 // POS terminal work
+#define TASK_CLASS_BACKGROUND 1 // LPUS backend jobs
+#define TASK_CLASS_COUNT      2
+
+#define TASK_KIND_POS_SCAN        0
+#define TASK_KIND_POS_LOOKUP      1
+#define TASK_KIND_POS_PAYMENT     2
+#define TASK_KIND_POS_RECEIPT     3
+#define TASK_KIND_LPUS_BATCH      4
+#define TASK_KIND_LPUS_INVENTORY  5
+#define TASK_KIND_LPUS_METADATA   6
+#define TASK_KIND_FOREGROUND      7 // unspecified POS task
+#define TASK_KIND_BACKGROUND      8 // unspecified LPUS task
+#define TASK_KIND_COUNT           9
+
+typedef struct {
+    const char* name;        // identifier used in CSV files
+    const char* description;
+    int task_class;
+    int sla_ms;              // default completion deadline after arrival
+} TaskKind;
+
+const TaskKind task_kinds[TASK_KIND_COUNT] = {
+    {"pos_scan",       "POS Scan Validation: Barcode Check",  TASK_CLASS_FOREGROUND,   50},
+    {"pos_lookup",     "POS Price Lookup: GUI Display",       TASK_CLASS_FOREGROUND,   50},
+    {"pos_payment",    "POS Payment Auth: Data Encryption",   TASK_CLASS_FOREGROUND,  100},
+    {"pos_receipt",    "POS Receipt Gen: Log Transaction",    TASK_CLASS_FOREGROUND,  100},
+    {"lpus_batch",     "LPUS Batch Update: SQL DB Write",     TASK_CLASS_BACKGROUND, 1000},
+    {"lpus_inventory", "LPUS Inventory Sync: Stock Upload",   TASK_CLASS_BACKGROUND, 1000},
+    {"lpus_metadata",  "LPUS Metadata Refresh: Cache Update", TASK_CLASS_BACKGROUND, 2000},
+    {"Foreground",     "POS Task",                            TASK_CLASS_FOREGROUND,  100},
+    {"Background",     "LPUS Task",                           TASK_CLASS_BACKGROUND, 1000}
+};
+
+const char* task_class_names[TASK_CLASS_COUNT] = {"Foreground", "Background"};
+
+// Kind index for a CSV type column, -1 if unknown
+int task_kind_lookup(const char* name) {
+    for (int i = 0; i < TASK_KIND_COUNT; i++) {
+        if (strcmp(task_kinds[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Records and files
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t pid;
+    uint8_t kind;        // TASK_KIND_*
+    uint8_t priority;    // 1=highest, 5=lowest
+    uint16_t deadline_ms; // SLA deadline after arrival, 0 = the kind's sla_ms
+    int64_t arrival_ns;
+    int64_t burst_ns;
+} WorkloadRecord;        // 24 bytes
+
+#define WORKLOAD_MAGIC "PCWL"
+#define WORKLOAD_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t reserved;
+    uint64_t count;
+} WorkloadFileHeader;    // 24 bytes
+
+typedef struct {
+    const WorkloadRecord* records;
+    size_t count;
+    const char* name;        // file path, or "PrimeCart reference workload"
+    void* map_base;          // binary trace mapping, NULL otherwise
+    size_t map_size;
+    WorkloadRecord* owned;   // heap records (CSV), NULL otherwise
+    int streamed;            // --stream: no records, each run reads the file (WorkloadStream)
+} Workload;
+
+// PrimeCart reference workload: POS foreground tasks competing with LPUS
+// background jobs (P1-P7), times in ns
+const WorkloadRecord reference_workload[] = {
+    {1, TASK_KIND_LPUS_BATCH,     4, 0, 0 * 1000000LL, 20 * 1000000LL},
+    {2, TASK_KIND_POS_SCAN,       1, 0, 1 * 1000000LL,  6 * 1000000LL},
+    {3, TASK_KIND_POS_LOOKUP,     1, 0, 2 * 1000000LL,  4 * 1000000LL},
+    {4, TASK_KIND_LPUS_INVENTORY, 4, 0, 4 * 1000000LL, 12 * 1000000LL},
+    {5, TASK_KIND_POS_PAYMENT,    2, 0, 5 * 1000000LL,  8 * 1000000LL},
+    {6, TASK_KIND_LPUS_METADATA,  5, 0, 7 * 1000000LL, 10 * 1000000LL},
+    {7, TASK_KIND_POS_RECEIPT,    1, 0, 9 * 1000000LL,  4 * 1000000LL}
+};
+
+void workload_reference(Workload* w) {
+    memset(w, 0, sizeof(*w));
+    w->records = reference_workload;
+    w->count = sizeof(reference_workload) / sizeof(reference_workload[0]);
+    w->name = "PrimeCart reference workload";
+}
+
+void workload_free(Workload* w) {
+    if (w->map_base != NULL) {
+        munmap(w->map_base, w->map_size);
+    }
+    free(w->owned);
+    memset(w, 0, sizeof(*w));
+}
+
+// The field rules shared by CSV and binary input; a zero or negative
+// burst would never complete
+int workload_record_valid(const WorkloadRecord* rec) {
+    return rec->kind < TASK_KIND_COUNT && rec->burst_ns > 0 && rec->arrival_ns >= 0 &&
+           rec->priority >= 1; // priority is 1..255
+}
+
+// Maps a binary trace read-only and checks its header. Returns the mapping
+// (header first), NULL after printing why.
+void* workload_map_binary(const char* path, size_t* map_size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror(path);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    if (size < sizeof(WorkloadFileHeader)) {
+        fprintf(stderr, "%s: truncated workload header\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror("workload: mmap failed");
+        return NULL;
+    }
+
+    const WorkloadFileHeader* header = (const WorkloadFileHeader*)base;
+    if (memcmp(header->magic, WORKLOAD_MAGIC, 4) != 0 ||
+        header->version != WORKLOAD_VERSION ||
+        header->record_size != sizeof(WorkloadRecord) ||
+        header->count > (size - sizeof(WorkloadFileHeader)) / sizeof(WorkloadRecord)) {
+        fprintf(stderr, "%s: not a PrimeCart v%d workload or size mismatch\n", path, WORKLOAD_VERSION);
+        munmap(base, size);
+        return NULL;
+    }
+    *map_size = size;
+    return base;
+}
+
+int workload_load_binary(Workload* w, const char* path) {
+    size_t size;
+    void* base = workload_map_binary(path, &size);
+    if (base == NULL) return -1;
+    const WorkloadFileHeader* header = (const WorkloadFileHeader*)base;
+
+    // Records are consumed front to back exactly once
+    madvise(base, size, MADV_SEQUENTIAL);
+
+    const WorkloadRecord* records = (const WorkloadRecord*)((const char*)base + sizeof(WorkloadFileHeader));
+    for (uint64_t i = 0; i < header->count; i++) {
+        const char* problem = NULL;
+        if (!workload_record_valid(&records[i])) {
+            problem = "invalid kind, burst, arrival or priority";
+        } else if (i > 0 && records[i].arrival_ns < records[i - 1].arrival_ns) {
+            problem = "records must be sorted by arrival time";
+        }
+        if (problem != NULL) {
+            fprintf(stderr, "%s: record %llu: %s\n", path, (unsigned long long)i, problem);
+            munmap(base, size);
+            return -1;
+        }
+    }
+
+    w->records = records;
+    w->count = (size_t)header->count;
+    w->map_base = base;
+    w->map_size = size;
+    return 0;
+}
+
+// The image is about to be replayed by several simulations at once: read
+// all of it ahead rather than dropping pages behind one sequential reader
+void workload_prepare_shared(const Workload* w) {
+    if (w->map_base != NULL) {
+        madvise(w->map_base, w->map_size, MADV_NORMAL);
+        madvise(w->map_base, w->map_size, MADV_WILLNEED);
+    }
+}
+
+// Parses one CSV data line. Returns 1 on success, 0 for a header/blank line,
+// -1 on a malformed line.
+int workload_parse_csv_line(char* line, WorkloadRecord* rec) {
+    char* fields[6];
+    int n = 0;
+    char* cursor = line;
+
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+    if (*cursor == '\0' || *cursor == '\n' || *cursor == '\r' || *cursor == '#') return 0;
+
+    while (n < 6) {
+        fields[n++] = cursor;
+        char* comma = strchr(cursor, ',');
+        if (comma == NULL) break;
+        *comma = '\0';
+        cursor = comma + 1;
+    }
+    if (n < 5) return -1;
+    fields[n - 1][strcspn(fields[n - 1], "\r\n")] = '\0';
+    for (int i = 0; i < n; i++) {
+        while (*fields[i] == ' ') fields[i]++;
+        char* end = fields[i] + strlen(fields[i]);
+        while (end > fields[i] && end[-1] == ' ') *--end = '\0';
+    }
+
+    const char* pid = fields[0];
+    if (*pid == 'P' || *pid == 'p') pid++;
+    if (!isdigit((unsigned char)*pid)) return strcmp(fields[0], "pid") == 0 ? 0 : -1;
+
+    int kind = task_kind_lookup(fields[1]);
+    if (kind < 0) return -1;
+
+    char* end;
+    double arrival_ms = strtod(fields[2], &end);
+    if (end == fields[2] || arrival_ms < 0) return -1;
+    double burst_ms = strtod(fields[3], &end);
+    if (end == fields[3] || burst_ms <= 0) return -1;
+    long priority = strtol(fields[4], &end, 10);
+    if (end == fields[4] || priority < 1 || priority > 255) return -1;
+
+    // Deadlines are kept relative to arrival, in whole ms (rounded up)
+    long deadline_ms = 0;
+    if (n == 6 && *fields[5] != '\0') {
+        int absolute = *fields[5] == '@';
+        const char* value = fields[5] + absolute;
+        double ms = strtod(value, &end);
+        if (end == value) return -1;
+        if (absolute) ms -= arrival_ms;
+        if (ms <= 0 || ms > UINT16_MAX) return -1;
+        deadline_ms = (long)ms;
+        if (deadline_ms < ms) deadline_ms++;
+    }
+
+    memset(rec, 0, sizeof(*rec));
+    rec->pid = (uint32_t)strtoul(pid, NULL, 10);
+    rec->kind = (uint8_t)kind;
+    rec->priority = (uint8_t)priority;
+    rec->deadline_ms = (uint16_t)deadline_ms;
+    rec->arrival_ns = (int64_t)(arrival_ms * 1000000.0 + 0.5);
+    rec->burst_ns = (int64_t)(burst_ms * 1000000.0 + 0.5);
+    return workload_record_valid(rec) ? 1 : -1;
+}
+
+// ---------------------------------------------------------------------------
+// Reading record by record
+// ---------------------------------------------------------------------------
+
+#define WORKLOAD_STREAM_RELEASE (1 << 20) // mapped bytes given back at a time
+
+// A trace read front to back in constant memory: CSV through a line buffer,
+// binary through its mapping with the pages behind the cursor given back.
+// Every record is checked as it is read, including the arrival order.
+typedef struct {
+    const char* path;
+    FILE* file;              // CSV, NULL for binary
+    long line_number;
+    char* map_base;          // binary
+    size_t map_size;
+    size_t next;             // binary: index of the next record
+    size_t count;
+    size_t released;         // binary: mapped bytes already given back
+    size_t read;             // records returned so far
+    int64_t last_arrival;
+} WorkloadStream;
+
+int workload_stream_open_csv(WorkloadStream* s, const char* path) {
+    memset(s, 0, sizeof(*s));
+    s->path = path;
+    s->file = fopen(path, "r");
+    if (s->file == NULL) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+// Opens a CSV or binary trace, telling them apart by the binary magic
+int workload_stream_open(WorkloadStream* s, const char* path) {
+    char magic[4] = {0};
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+    size_t got = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+    if (got != sizeof(magic) || memcmp(magic, WORKLOAD_MAGIC, 4) != 0) {
+        return workload_stream_open_csv(s, path);
+    }
+
+    memset(s, 0, sizeof(*s));
+    s->path = path;
+    s->map_base = (char*)workload_map_binary(path, &s->map_size);
+    if (s->map_base == NULL) return -1;
+    s->count = (size_t)((const WorkloadFileHeader*)s->map_base)->count;
+    madvise(s->map_base, s->map_size, MADV_SEQUENTIAL);
+    return 0;
+}
+
+// Returns 1 with the next record, 0 at the end, -1 on a bad record
+int workload_stream_read(WorkloadStream* s, WorkloadRecord* rec) {
+    if (s->file != NULL) {
+        char line[512];
+        int parsed = 0;
+        while (parsed == 0) {
+            if (fgets(line, sizeof(line), s->file) == NULL) return 0;
+            s->line_number++;
+            parsed = workload_parse_csv_line(line, rec);
+        }
+        if (parsed < 0) {
+            fprintf(stderr, "%s:%ld: expected pid,type,arrival_ms,burst_ms,priority[,deadline_ms]\n",
+                    s->path, s->line_number);
+            return -1;
+        }
+        if (s->read > 0 && rec->arrival_ns < s->last_arrival) {
+            fprintf(stderr, "%s:%ld: records must be sorted by arrival time\n", s->path, s->line_number);
+            return -1;
+        }
+    } else {
+        if (s->next == s->count) return 0;
+        size_t offset = sizeof(WorkloadFileHeader) + s->next * sizeof(WorkloadRecord);
+        memcpy(rec, s->map_base + offset, sizeof(*rec));
+        if (!workload_record_valid(rec)) {
+            fprintf(stderr, "%s: record %zu: invalid kind, burst, arrival or priority\n", s->path, s->next);
+            return -1;
+        }
+        if (s->read > 0 && rec->arrival_ns < s->last_arrival) {
+            fprintf(stderr, "%s: record %zu: records must be sorted by arrival time\n", s->path, s->next);
+            return -1;
+        }
+        s->next++;
+
+        // Pages behind the cursor are never read again
+        size_t done = offset & ~(size_t)(WORKLOAD_STREAM_RELEASE - 1);
+        if (done > s->released) {
+            madvise(s->map_base + s->released, done - s->released, MADV_DONTNEED);
+            s->released = done;
+        }
+    }
+    s->last_arrival = rec->arrival_ns;
+    s->read++;
+    return 1;
+}
+
+void workload_stream_close(WorkloadStream* s) {
+    if (s->file != NULL) fclose(s->file);
+    if (s->map_base != NULL) munmap(s->map_base, s->map_size);
+    memset(s, 0, sizeof(*s));
+}
+
+// CSV is parsed line by line into compact 24-byte records
+int workload_load_csv(Workload* w, const char* path) {
+    WorkloadStream stream;
+    if (workload_stream_open_csv(&stream, path) != 0) return -1;
+
+    size_t capacity = 1024;
+    WorkloadRecord* records = (WorkloadRecord*)malloc(sizeof(WorkloadRecord) * capacity);
+    size_t count = 0;
+    WorkloadRecord rec;
+    int result = 0;
+    while (records != NULL && (result = workload_stream_read(&stream, &rec)) > 0) {
+        if (count == capacity) {
+            capacity *= 2;
+            WorkloadRecord* grown = (WorkloadRecord*)realloc(records, sizeof(WorkloadRecord) * capacity);
+            if (grown == NULL) free(records);
+            records = grown;
+            if (records == NULL) break;
+        }
+        records[count++] = rec;
+    }
+    workload_stream_close(&stream);
+
+    if (records == NULL) {
+        perror("workload: malloc failed");
+        return -1;
+    }
+    if (result < 0) {
+        free(records);
+        return -1;
+    }
+    w->records = records;
+    w->owned = records;
+    w->count = count;
+    return 0;
+}
+
+// Loads a CSV or binary trace, telling them apart by the binary magic
+int workload_load(Workload* w, const char* path) {
+    memset(w, 0, sizeof(*w));
+
+    char magic[4] = {0};
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+    size_t got = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+
+    int result = (got == sizeof(magic) && memcmp(magic, WORKLOAD_MAGIC, 4) == 0)
+                     ? workload_load_binary(w, path)
+                     : workload_load_csv(w, path);
+    if (result == 0) {
+        w->name = path;
+    }
+    return result;
+}
+
+// --stream: check the whole trace once and count it, but keep no records;
+// every simulation then reads it afresh through its own WorkloadStream
+int workload_open_streamed(Workload* w, const char* path) {
+    memset(w, 0, sizeof(*w));
+    WorkloadStream stream;
+    if (workload_stream_open(&stream, path) != 0) return -1;
+    WorkloadRecord rec;
+    int result;
+    do {
+        result = workload_stream_read(&stream, &rec);
+    } while (result > 0);
+    w->count = stream.read;
+    workload_stream_close(&stream);
+    if (result < 0) return -1;
+    w->name = path;
+    w->streamed = 1;
+    return 0;
+}
+
+// SimSource callbacks over a heap-allocated WorkloadStream
+int workload_stream_next(void* ctx, WorkloadRecord* rec) {
+    int result = workload_stream_read((WorkloadStream*)ctx, rec);
+    if (result < 0) exit(1); // the file changed since workload_open_streamed
+    return result;
+}
+
+void workload_stream_free(void* ctx) {
+    workload_stream_close((WorkloadStream*)ctx);
+    free(ctx);
+}
+
+// ---------------------------------------------------------------------------
+// Writing traces (generator, converters)
+// ---------------------------------------------------------------------------
+
+#define WORKLOAD_FORMAT_CSV    0
+#define WORKLOAD_FORMAT_BINARY 1
+
+// Binary traces declare their record count up front
+void workload_write_header(FILE* out, int format, uint64_t count) {
+    if (format == WORKLOAD_FORMAT_BINARY) {
+        WorkloadFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, WORKLOAD_MAGIC, 4);
+        header.version = WORKLOAD_VERSION;
+        header.record_size = sizeof(WorkloadRecord);
+        header.count = count;
+        fwrite(&header, sizeof(header), 1, out);
+    } else {
+        fprintf(out, "pid,type,arrival_ms,burst_ms,priority\n");
+    }
+}
+
+// CSV times are written with ns precision so a CSV round trip is exact
+void workload_write_record(FILE* out, int format, const WorkloadRecord* rec) {
+    if (format == WORKLOAD_FORMAT_BINARY) {
+        fwrite(rec, sizeof(*rec), 1, out);
+    } else {
+        fprintf(out, "P%u,%s,%lld.%06lld,%lld.%06lld,%u",
+                rec->pid,
+                task_kinds[rec->kind].name,
+                (long long)(rec->arrival_ns / 1000000), (long long)(rec->arrival_ns % 1000000),
+                (long long)(rec->burst_ns / 1000000), (long long)(rec->burst_ns % 1000000),
+                rec->priority);
+        if (rec->deadline_ms != 0) {
+            fprintf(out, ",%u", rec->deadline_ms);
+        }
+        fputc('\n', out);
+    }
+}
+
+#endif // PRIMECART_WORKLOAD_H